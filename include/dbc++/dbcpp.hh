@@ -12,11 +12,14 @@
 #include <dbc++/dbi/statement.hh>
 
 #include <dbc++/internal/base_types.hh>
+#include <dbc++/internal/cluster_pool.hh>
 #include <dbc++/internal/pool.hh>
 #include <dbc++/internal/connection.hh>
 #include <dbc++/internal/field.hh>
 #include <dbc++/internal/resultset.hh>
+#include <dbc++/internal/sharded_pool.hh>
 #include <dbc++/internal/statement.hh>
+#include <dbc++/internal/typed_query.hh>
 // clang-format on
 
 namespace dbcpp {
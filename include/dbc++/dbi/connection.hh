@@ -2,12 +2,23 @@
 #define __DBCPP_DBI_CONNECTION_HH__
 
 #include "statement.hh"
+#include "statement_cache.hh"
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace dbcpp {
   namespace interface {
     /** Database connection interface */
     struct Connection {
+      /** Non-blocking connection establishment state */
+      enum ConnectState {
+        CONNECT_FAILED  = 0, /**< Establishment failed */
+        CONNECT_READING = 1, /**< Waiting for the socket to become readable */
+        CONNECT_WRITING = 2, /**< Waiting for the socket to become writable */
+        CONNECT_OK      = 3, /**< Connection established */
+      };
 
       /**
        * @brief Establish the database connection
@@ -15,6 +26,26 @@ namespace dbcpp {
        */
       virtual bool connect( ) = 0;
 
+      /**
+       * @brief Begin establishing the database connection without blocking
+       *
+       * Drivers without non-blocking support connect synchronously
+       * @return connection state, poll socket( ) per the state and call connectPoll( ) when ready
+       */
+      virtual ConnectState connectStart( ) { return connect( ) ? CONNECT_OK : CONNECT_FAILED; }
+
+      /**
+       * @brief Advance a non-blocking connection establishment
+       * @return connection state
+       */
+      virtual ConnectState connectPoll( ) { return CONNECT_FAILED; }
+
+      /**
+       * @brief Get the socket of the connection, for polling
+       * @return socket descriptor, -1 if none
+       */
+      virtual int socket( ) const { return -1; }
+
       /**
        * @brief Disconnect from the database
        * @return true on success, false on failure
@@ -33,6 +64,26 @@ namespace dbcpp {
        */
       virtual bool test( ) = 0;
 
+      /**
+       * @brief Begin testing the viability of the connection without blocking
+       *
+       * Drivers without non-blocking support test synchronously
+       * @return test state, polled like a connection establishment; CONNECT_OK if good
+       */
+      virtual ConnectState testStart( ) { return test( ) ? CONNECT_OK : CONNECT_FAILED; }
+
+      /**
+       * @brief Advance a non-blocking connection test
+       * @return test state
+       */
+      virtual ConnectState testPoll( ) { return CONNECT_FAILED; }
+
+      /**
+       * @brief Check the connection state already known to the client, without a server round trip
+       * @return true if the connection appears usable, false if not
+       */
+      virtual bool alive( ) { return true; }
+
       /**
        * @brief Enable or disable the automatic commits
        * @param ac auto commit flag
@@ -51,12 +102,100 @@ namespace dbcpp {
        */
       virtual void rollback( ) = 0;
 
+      /**
+       * @brief Get the server log position reached by the last commit on this connection,
+       *        for read-your-writes routing to replicas
+       * @return log position, 0 if unknown, not tracked or not supported by the driver
+       */
+      virtual uint64_t commitPosition( ) const { return 0; }
+
+      /**
+       * @brief Capture the log position reached by each commit, for commitPosition( ); off by
+       *        default, as it costs every commit an extra query
+       * @param track true to capture, false to stop
+       * @return true if set, false if not supported by the driver
+       */
+      virtual bool trackCommitPosition( bool track ) { return false; }
+
+      /**
+       * @brief Query the server log position visible to reads on this connection: replayed
+       *        so far on a replica, written so far on a primary
+       * @return log position, 0 if unknown or not supported by the driver
+       */
+      virtual uint64_t replayPosition( ) { return 0; }
+
+      /**
+       * @brief Set a session parameter (e.g. search_path, TimeZone or role); the change is
+       *        sent with the next statement, and not at all if the parameter has the value.
+       *        Sent within the transaction, it is undone by a rollback; a commit or rollback
+       *        before the next statement leaves it to be sent then
+       * @param name parameter name, as the server reports it (e.g. "TimeZone")
+       * @param value parameter value
+       * @return true if set, false if the driver has no session parameters
+       */
+      virtual bool setSessionParam( const std::string &name, const std::string &value ) { return false; }
+
+      /**
+       * @brief Get a session parameter, as last reported by the server or set on this connection
+       * @param name parameter name
+       * @return parameter value, empty if unknown
+       */
+      virtual std::string sessionParam( const std::string &name ) { return { }; }
+
       /**
        * @brief Create a prepared statement
        * @param query query string
        * @return prepared statement
        */
       virtual std::shared_ptr< Statement > createStatement( std::string query ) = 0;
+
+      /**
+       * @brief Get a prepared statement, reusing an idle cached statement for the query when
+       *        the statement cache is enabled
+       * @param query query string
+       * @return prepared statement
+       */
+      std::shared_ptr< Statement > prepareStatement( const std::string &query ) {
+        auto statement = statements.get( query );
+
+        if ( !statement ) {
+          statement = createStatement( query );
+          statements.put( query, statement );
+        }
+
+        return statement;
+      }
+
+      /**
+       * @brief Prepare statements ahead of their first use, keeping them in the statement
+       *        cache; drivers able to prepare several in one round trip do so. A statement
+       *        failing to prepare does not keep the others from being prepared
+       * @param queries query strings
+       * @return error message, by query failing to prepare
+       * @note Throws DBException
+       */
+      virtual std::map< std::string, std::string > prepareStatements( const std::vector< std::string > &queries ) {
+        std::map< std::string, std::string > failed;
+
+        for ( auto &&query : queries ) {
+          try {
+            prepareStatement( query );
+          } catch ( std::exception &ex ) {
+            failed[ query ] = ex.what( );
+          }
+        }
+
+        return failed;
+      }
+
+      /**
+       * @brief Get the connection's prepared statement cache (disabled unless sized)
+       * @return statement cache
+       */
+      StatementCache &statementCache( ) { return statements; }
+
+     private:
+      StatementCache statements;
     };
   } // namespace interface
 } // namespace dbcpp
@@ -169,6 +169,48 @@ namespace dbcpp {
         get( str );
         value = std::strtold( str.c_str( ), 0x00 );
       }
+
+      /**
+       * @brief Get the value of the field into a variable of a run time chosen type
+       * @param type variable type
+       * @param target variable
+       */
+      void get( HostType type, void *target ) const {
+        switch ( type ) {
+          case HOST_BOOL:
+            return get( *static_cast< bool * >( target ) );
+          case HOST_INT8:
+            return get( *static_cast< int8_t * >( target ) );
+          case HOST_UINT8:
+            return get( *static_cast< uint8_t * >( target ) );
+          case HOST_INT16:
+            return get( *static_cast< int16_t * >( target ) );
+          case HOST_UINT16:
+            return get( *static_cast< uint16_t * >( target ) );
+          case HOST_INT32:
+            return get( *static_cast< int32_t * >( target ) );
+          case HOST_UINT32:
+            return get( *static_cast< uint32_t * >( target ) );
+          case HOST_INT64:
+            return get( *static_cast< int64_t * >( target ) );
+          case HOST_UINT64:
+            return get( *static_cast< uint64_t * >( target ) );
+          case HOST_FLOAT:
+            return get( *static_cast< float * >( target ) );
+          case HOST_DOUBLE:
+            return get( *static_cast< double * >( target ) );
+          case HOST_STRING:
+            return get( *static_cast< std::string * >( target ) );
+          case HOST_VARBYTE: {
+            auto &value = *static_cast< VarByte * >( target );
+
+            value.clear( ); // get( ) may append
+            return get( value );
+          }
+          case HOST_TIME:
+            return get( *static_cast< DBTime * >( target ) );
+        }
+      }
     };
   } // namespace interface
 } // namespace dbcpp
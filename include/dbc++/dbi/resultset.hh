@@ -51,6 +51,21 @@ namespace dbcpp {
        * @return result field
        */
       virtual std::shared_ptr< Field > get( std::string field ) const = 0;
+
+      /**
+       * @brief Bind a column to a variable, set from each row next( ) advances to
+       * @param field column number
+       * @param type variable type
+       * @param target variable, which must outlive the binding; left unchanged for a null
+       * @param isNull null indicator, set from each row; nullptr if not wanted
+       * @return true if bound, false on failure or if the driver does not bind columns
+       */
+      virtual bool bindColumn( size_t field, HostType type, void *target, bool *isNull ) { return false; }
+
+      /**
+       * @brief Remove the column bindings
+       */
+      virtual void unbindColumns( ) {}
     };
 
   } // namespace interface
@@ -4,6 +4,7 @@
 #include "resultset.hh"
 
 #include <memory>
+#include <vector>
 
 namespace dbcpp {
   namespace interface {
@@ -138,6 +139,32 @@ namespace dbcpp {
        */
       virtual bool setParam( size_t parameter, VarByte value ) = 0;
 
+      /**
+       * @brief Set the string parameter value from a borrowed buffer, which must stay
+       *        unchanged until the statement is executed
+       *
+       * Drivers without borrowed binds copy the value
+       * @param parameter parameter index (0 start)
+       * @param value parameter value
+       * @return true on success, false on failure
+       */
+      virtual bool setParam( size_t parameter, StringRef value ) {
+        return setParam( parameter, std::string( value.data, value.size ) );
+      }
+
+      /**
+       * @brief Set the binary blob parameter value from a borrowed buffer, which must stay
+       *        unchanged until the statement is executed
+       *
+       * Drivers without borrowed binds copy the value
+       * @param parameter parameter index (0 start)
+       * @param value parameter value
+       * @return true on success, false on failure
+       */
+      virtual bool setParam( size_t parameter, ByteRef value ) {
+        return setParam( parameter, VarByte( value.data, value.data + value.size ) );
+      }
+
       /**
        * @brief Set the date/time parameter value
        * @param parameter parameter index (0 start)
@@ -146,6 +173,24 @@ namespace dbcpp {
        */
       virtual bool setParam( size_t parameter, DBTime value ) = 0;
 
+      /**
+       * @brief Bind the parameter to a host variable, whose current value is read by every
+       *        execution and addBatch( ) until unbound; setParam( ) does not replace it
+       * @param parameter parameter index (0 start)
+       * @param type host variable type
+       * @param address host variable, which must outlive the binding
+       * @param isNull null indicator, nullptr if never null
+       * @return true if bound, false on failure or if the driver does not bind host variables
+       */
+      virtual bool bindParam( size_t parameter, HostType type, const void *address, const bool *isNull ) {
+        return false;
+      }
+
+      /**
+       * @brief Remove the host variable bindings
+       */
+      virtual void unbindParams( ) {}
+
       /**
        * @brief Reset the statement for reuse
        */
@@ -170,6 +215,30 @@ namespace dbcpp {
        * @return result set
        */
       virtual std::shared_ptr< ResultSet > getResults( ) = 0;
+
+      /**
+       * @brief Add the bound parameter set to the batch run by executeBatch( )
+       *
+       * Drivers without batch support execute each parameter set as it is added
+       * @note Throws DBException
+       */
+      virtual void addBatch( ) { batched.push_back( executeUpdate( ) ); }
+
+      /**
+       * @brief Execute the modification query once per parameter set in the batch, emptying
+       *        the batch
+       * @note Throws DBException
+       * @return number of affected rows, per parameter set
+       */
+      virtual std::vector< int > executeBatch( ) {
+        std::vector< int > counts;
+
+        counts.swap( batched );
+        return counts;
+      }
+
+     private:
+      std::vector< int > batched;
     };
   } // namespace interface
 } // namespace dbcpp
@@ -0,0 +1,127 @@
+#ifndef __DBCPP_DBI_STATEMENT_CACHE_HH__
+#define __DBCPP_DBI_STATEMENT_CACHE_HH__
+
+#include "statement.hh"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace dbcpp {
+  namespace interface {
+    /**
+     * Least recently used cache of prepared statements, keyed by query text
+     *
+     * A cached statement is only handed out while nothing else references it (no
+     * statement wrapper or result set from a previous use is still alive), and is reset
+     * before reuse. Not synchronized; a connection is used by one thread at a time.
+     * Cached statements reference their connection, so the connection clears its cache
+     * on disconnect( ) to release them.
+     */
+    class StatementCache {
+     public:
+      using statement_t = std::shared_ptr< Statement >;
+
+      /**
+       * @brief Create a statement cache
+       * @param _capacity maximum cached statements, 0 to disable caching
+       */
+      explicit StatementCache( size_t _capacity = 0 )
+        : capacity( _capacity )
+        , hitCount( 0 )
+        , missCount( 0 )
+        , evictionCount( 0 ) {}
+
+      /**
+       * @brief Get an idle cached statement for a query
+       * @param query query string
+       * @return reset statement, null if none is cached or the cached statement is in use
+       */
+      statement_t get( const std::string &query ) {
+        if ( capacity == 0 ) {
+          return nullptr;
+        }
+
+        auto found = index.find( query );
+
+        if ( ( found == index.end( ) ) || ( found->second->second.use_count( ) > 1 ) ) {
+          ++missCount;
+          return nullptr;
+        }
+
+        entries.splice( entries.begin( ), entries, found->second );
+        found->second->second->reset( );
+        ++hitCount;
+
+        return found->second->second;
+      }
+
+      /**
+       * @brief Identify if a statement is cached for a query, in use or not, without
+       *        counting a hit or miss
+       * @param query query string
+       * @return true if cached, false if not
+       */
+      bool contains( const std::string &query ) const { return index.find( query ) != index.end( ); }
+
+      /**
+       * @brief Cache a statement, evicting the least recently used when full
+       * @param query query string
+       * @param statement prepared statement for the query
+       */
+      void put( const std::string &query, statement_t statement ) {
+        if ( ( capacity == 0 ) || ( index.find( query ) != index.end( ) ) ) {
+          return;
+        }
+
+        entries.emplace_front( query, std::move( statement ) );
+        index[ query ] = entries.begin( );
+
+        trim( );
+      }
+
+      /**
+       * @brief Change the cache capacity, evicting the least recently used statements as needed
+       * @param _capacity maximum cached statements, 0 to disable caching
+       */
+      void resize( size_t _capacity ) {
+        capacity = _capacity;
+        trim( );
+      }
+
+      /**
+       * @brief Release all cached statements (e.g. before the connection is closed)
+       */
+      void clear( ) {
+        index.clear( );
+        entries.clear( );
+      }
+
+      size_t   size( ) const { return entries.size( ); }
+      uint64_t hits( ) const { return hitCount; }
+      uint64_t misses( ) const { return missCount; }
+      uint64_t evictions( ) const { return evictionCount; }
+
+     private:
+      using entry_t = std::pair< std::string, statement_t >;
+
+      void trim( ) {
+        while ( entries.size( ) > capacity ) {
+          index.erase( entries.back( ).first );
+          entries.pop_back( );
+          ++evictionCount;
+        }
+      }
+
+      std::list< entry_t >                                              entries;
+      std::unordered_map< std::string, std::list< entry_t >::iterator > index;
+      size_t                                                            capacity;
+      uint64_t                                                          hitCount;
+      uint64_t                                                          missCount;
+      uint64_t                                                          evictionCount;
+    };
+  } // namespace interface
+} // namespace dbcpp
+
+#endif
@@ -14,6 +14,35 @@ namespace dbcpp {
   /** Variable Byte */
   using VarByte = std::vector< uint8_t >;
 
+  /**
+   * Borrowed character string parameter, bound without a copy: the caller's buffer must
+   * stay unchanged until the statement is executed (executeBatch( ) for a batched set)
+   */
+  struct StringRef {
+    const char *data;
+    size_t      size;
+
+    StringRef( const char *_data, size_t _size )
+      : data( _data ? _data : "" )
+      , size( _data ? _size : 0 ) {}
+    explicit StringRef( const std::string &value )
+      : StringRef( value.data( ), value.size( ) ) {}
+    explicit StringRef( std::string && ) = delete;
+  };
+
+  /** Borrowed binary blob parameter, with the StringRef lifetime */
+  struct ByteRef {
+    const uint8_t *data;
+    size_t         size;
+
+    ByteRef( const void *_data, size_t _size )
+      : data( static_cast< const uint8_t * >( _data ? _data : "" ) )
+      , size( _data ? _size : 0 ) {}
+    explicit ByteRef( const VarByte &value )
+      : ByteRef( value.data( ), value.size( ) ) {}
+    explicit ByteRef( VarByte && ) = delete;
+  };
+
   /**
    * Database Exception
    */
@@ -27,6 +56,16 @@ namespace dbcpp {
     const char *what( ) const noexcept override { return message.c_str( ); }
   };
 
+  /**
+   * Connection pool admission failure: the pool rejected the checkout without waiting,
+   * because its circuit breaker is open or too many checkouts are already waiting
+   */
+  class PoolUnavailable : public DBException {
+   public:
+    explicit PoolUnavailable( const std::string &msg )
+      : DBException( msg ) {}
+  };
+
   /** Database Types */
   enum FieldType {
     UNKNOWN = 0,        /**< Unspecified type */
@@ -87,6 +126,24 @@ namespace dbcpp {
     XML     = 26,       /**< Stored XML type                         */
   };
 
+  /** Host variable types, for parameters bound by address */
+  enum HostType {
+    HOST_BOOL    = 0,  /**< bool        */
+    HOST_INT8    = 1,  /**< int8_t      */
+    HOST_UINT8   = 2,  /**< uint8_t     */
+    HOST_INT16   = 3,  /**< int16_t     */
+    HOST_UINT16  = 4,  /**< uint16_t    */
+    HOST_INT32   = 5,  /**< int32_t     */
+    HOST_UINT32  = 6,  /**< uint32_t    */
+    HOST_INT64   = 7,  /**< int64_t     */
+    HOST_UINT64  = 8,  /**< uint64_t    */
+    HOST_FLOAT   = 9,  /**< float       */
+    HOST_DOUBLE  = 10, /**< double      */
+    HOST_STRING  = 11, /**< std::string */
+    HOST_VARBYTE = 12, /**< VarByte     */
+    HOST_TIME    = 13, /**< DBTime      */
+  };
+
   namespace FieldTypeDecoder {
     template < typename T >
     struct type {
@@ -112,6 +169,8 @@ namespace dbcpp {
     FieldTypeDecodeEntry( double, DOUBLE );
     FieldTypeDecodeEntry( std::string, VARCHAR );
     FieldTypeDecodeEntry( VarByte, VARBYTE );
+    FieldTypeDecodeEntry( StringRef, VARCHAR );
+    FieldTypeDecodeEntry( ByteRef, VARBYTE );
     FieldTypeDecodeEntry( DBTime, TIMESTAMP );
 #undef FieldTypeDecodeEntry
 
@@ -120,6 +179,34 @@ namespace dbcpp {
       return type< T >::value;
     }
   } // namespace FieldTypeDecoder
+
+  namespace HostTypeDecoder {
+    /** Only the HostType types can be bound by address */
+    template < typename T >
+    struct type;
+
+#define HostTypeDecodeEntry( _type, _hosttype )                                                                        \
+  template <>                                                                                                          \
+  struct type< _type > {                                                                                               \
+    static const HostType value = HostType::_hosttype;                                                                 \
+  }
+
+    HostTypeDecodeEntry( bool, HOST_BOOL );
+    HostTypeDecodeEntry( int8_t, HOST_INT8 );
+    HostTypeDecodeEntry( uint8_t, HOST_UINT8 );
+    HostTypeDecodeEntry( int16_t, HOST_INT16 );
+    HostTypeDecodeEntry( uint16_t, HOST_UINT16 );
+    HostTypeDecodeEntry( int32_t, HOST_INT32 );
+    HostTypeDecodeEntry( uint32_t, HOST_UINT32 );
+    HostTypeDecodeEntry( int64_t, HOST_INT64 );
+    HostTypeDecodeEntry( uint64_t, HOST_UINT64 );
+    HostTypeDecodeEntry( float, HOST_FLOAT );
+    HostTypeDecodeEntry( double, HOST_DOUBLE );
+    HostTypeDecodeEntry( std::string, HOST_STRING );
+    HostTypeDecodeEntry( VarByte, HOST_VARBYTE );
+    HostTypeDecodeEntry( DBTime, HOST_TIME );
+#undef HostTypeDecodeEntry
+  } // namespace HostTypeDecoder
 } // namespace dbcpp
 
 #endif
@@ -0,0 +1,141 @@
+#ifndef __DBCPP_INTERNAL_CIRCUIT_BREAKER_HH__
+#define __DBCPP_INTERNAL_CIRCUIT_BREAKER_HH__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace dbcpp {
+  namespace internal {
+    /**
+     * Lock-free circuit breaker
+     *
+     * CLOSED admits everything and opens after threshold consecutive failures. OPEN
+     * rejects everything until the cool down expires, then turns HALF_OPEN and admits a
+     * single probe; the probe's success closes the breaker, its failure re-opens it. Only
+     * the request admitted as the probe may give it up.
+     */
+    class CircuitBreaker {
+      using steady_clock_t = std::chrono::steady_clock;
+
+     public:
+      enum State {
+        CLOSED    = 0, /**< Healthy, admitting */
+        OPEN      = 1, /**< Unhealthy, rejecting */
+        HALF_OPEN = 2, /**< Cool down expired, admitting a single probe */
+      };
+
+      /**
+       * @brief Create a closed circuit breaker
+       * @param _threshold consecutive failures opening the breaker, 0 to never open
+       * @param _cooldown time spent open before probing
+       */
+      CircuitBreaker( size_t _threshold, steady_clock_t::duration _cooldown )
+        : threshold( _threshold )
+        , cooldown( _cooldown )
+        , state( CLOSED )
+        , failures( 0 )
+        , openedAt( 0 )
+        , probing( false ) {}
+
+      /**
+       * @brief Check whether a request is admitted, claiming the probe when half open
+       * @param probe set if the request was admitted as the probe
+       * @return true if admitted, false if rejected
+       */
+      bool admit( bool &probe ) {
+        auto current = state.load( );
+
+        if ( current == CLOSED ) {
+          return true;
+        }
+
+        if ( current == OPEN ) {
+          if ( steady_clock_t::now( ).time_since_epoch( ).count( ) - openedAt.load( ) < cooldown.count( ) ) {
+            return false;
+          }
+
+          state.compare_exchange_strong( current, HALF_OPEN );
+        }
+
+        bool expected = false;
+
+        probe = probing.compare_exchange_strong( expected, true );
+        return probe;
+      }
+
+      /**
+       * @brief Record a success, closing the breaker
+       */
+      void success( ) {
+        if ( failures.load( std::memory_order_relaxed ) ) {
+          failures.store( 0 );
+        }
+
+        if ( state.load( ) != CLOSED ) {
+          state.store( CLOSED );
+        }
+      }
+
+      /**
+       * @brief Record the success of an admitted request, closing the breaker
+       * @param probe whether the request holds the probe, released and cleared
+       */
+      void success( bool &probe ) {
+        success( );
+        abandon( probe );
+      }
+
+      /**
+       * @brief Record a failure, opening the breaker when half open or past the threshold
+       */
+      void failure( ) {
+        if ( threshold == 0 ) {
+          return;
+        }
+
+        if ( ( state.load( ) == HALF_OPEN ) || ( failures.fetch_add( 1 ) + 1 >= threshold ) ) {
+          openedAt.store( steady_clock_t::now( ).time_since_epoch( ).count( ) );
+          state.store( OPEN );
+        }
+      }
+
+      /**
+       * @brief Record the failure of an admitted request, opening the breaker as above
+       * @param probe whether the request holds the probe, released and cleared
+       */
+      void failure( bool &probe ) {
+        failure( );
+        abandon( probe );
+      }
+
+      /**
+       * @brief Give up an admitted request with no outcome (e.g. timed out), freeing the probe
+       *        if it holds it
+       * @param probe whether the request holds the probe, released and cleared
+       */
+      void abandon( bool &probe ) {
+        if ( probe ) {
+          probe = false;
+          probing.store( false );
+        }
+      }
+
+      /**
+       * @brief Get the breaker state
+       * @return state
+       */
+      State current( ) const { return static_cast< State >( state.load( ) ); }
+
+     private:
+      size_t                             threshold; /**< Consecutive failures opening the breaker */
+      steady_clock_t::duration           cooldown;  /**< Time spent open before probing */
+      std::atomic< int >                 state;     /**< Breaker state */
+      std::atomic< size_t >              failures;  /**< Consecutive failure count */
+      std::atomic< steady_clock_t::rep > openedAt;  /**< Time opened, steady clock ticks */
+      std::atomic< bool >                probing;   /**< Half open probe admitted */
+    };
+  } // namespace internal
+} // namespace dbcpp
+
+#endif
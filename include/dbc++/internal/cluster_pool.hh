@@ -0,0 +1,257 @@
+#ifndef __DBCPP_INTERNAL_CLUSTER_POOL_HH__
+#define __DBCPP_INTERNAL_CLUSTER_POOL_HH__
+
+#include "pool.hh"
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dbcpp {
+  namespace internal {
+    /** Multi-endpoint connection pool settings */
+    struct ClusterOptions {
+      /** Read-only checkout routing across the healthy replicas */
+      enum Routing {
+        LEAST_IN_FLIGHT = 0, /**< Fewest leased connections */
+        LOWEST_LATENCY  = 1, /**< Lowest health check round trip average */
+      };
+
+      PoolOptions               pool;                                       /**< Per endpoint pool settings */
+      Routing                   routing        = LEAST_IN_FLIGHT;           /**< Replica selection policy */
+      std::chrono::milliseconds healthInterval = std::chrono::seconds( 1 ); /**< Health check, failover wait */
+      std::chrono::milliseconds healthTimeout  = std::chrono::seconds( 1 ); /**< Health check deadline */
+      double                    latencyWeight  = 0.2;                       /**< Latency average sample weight */
+    };
+
+    /**
+     * Connection pool over a primary and its read replicas
+     *
+     * Each endpoint has its own Pool. Read-write checkouts go to the primary; read-only
+     * checkouts are spread across the healthy replicas, falling back to the primary when
+     * none is available. Every endpoint is probed, on a dedicated connection, each health
+     * check interval: an endpoint failing or missing the probe deadline stops receiving
+     * checkouts (its leased connections drain back as usual) until a probe succeeds again.
+     * A checkout finding no idle connection waits on the candidate endpoints in turn, a
+     * health check interval at a time, until its deadline.
+     *
+     * For read-your-writes consistency, a read-only checkout may carry the commit position
+     * of an earlier write (Connection::commitPosition( ), captured by the primary's
+     * connections); it is then only routed to the replicas whose replay position, as of
+     * their last health check, has caught up.
+     */
+    class ClusterPool {
+      using steady_clock_t = std::chrono::steady_clock;
+
+     public:
+      /** Endpoint role */
+      enum Role {
+        PRIMARY = 0, /**< Accepts writes */
+        REPLICA = 1, /**< Read only copy of the primary */
+      };
+
+      /** Checkout access mode */
+      enum Access {
+        READ_WRITE = 0, /**< Routed to the primary */
+        READ_ONLY  = 1, /**< Routed to a replica, or the primary if none is healthy */
+      };
+
+      /** Cluster endpoint */
+      struct Endpoint {
+        std::string uri;  /**< Connection uri */
+        Role        role; /**< Endpoint role */
+      };
+
+      /**
+       * @brief Create the endpoint pools and run a first health check
+       *
+       * An endpoint that can not be reached is created empty and marked down until a
+       * health check succeeds
+       * @param endpoints cluster endpoints, exactly one of which is the PRIMARY
+       * @param options cluster settings
+       * @throws DBException if there is not exactly one primary
+       */
+      ClusterPool( const std::vector< Endpoint > &endpoints, const ClusterOptions &options );
+
+      ~ClusterPool( );
+
+      /**
+       * @brief Get the number of endpoints
+       * @return endpoint count
+       */
+      size_t size( ) const { return members.size( ); }
+
+      /**
+       * @brief Get an endpoint
+       * @param index endpoint index, in construction order
+       * @return endpoint
+       */
+      const Endpoint &endpoint( size_t index ) const { return members[ index ]->endpoint; }
+
+      /**
+       * @brief Get an endpoint's pool, e.g. for its statistics
+       * @param index endpoint index, in construction order
+       * @return endpoint pool
+       */
+      Pool &pool( size_t index ) { return *members[ index ]->pool; }
+
+      /**
+       * @brief Check whether an endpoint passed its last health check
+       * @param index endpoint index, in construction order
+       * @return true if healthy, false if not
+       */
+      bool healthy( size_t index ) const { return members[ index ]->healthy.load( ); }
+
+      /**
+       * @brief Get an endpoint's health check round trip average
+       * @param index endpoint index, in construction order
+       * @return average latency
+       */
+      std::chrono::microseconds latency( size_t index ) const {
+        return std::chrono::microseconds( static_cast< int64_t >( members[ index ]->latency.load( ) ) );
+      }
+
+      /**
+       * @brief Get an endpoint's replay position as of its last health check
+       * @param index endpoint index, in construction order
+       * @return log position, 0 if unknown
+       */
+      uint64_t position( size_t index ) const { return members[ index ]->position.load( ); }
+
+      /**
+       * @brief Get a connection from the cluster, waiting without limit
+       * @param access checkout access mode
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if no endpoint for the access mode is healthy
+       */
+      Connection getConnection( Access                access   = READ_WRITE,
+                                PoolOptions::Priority priority = PoolOptions::NORMAL,
+                                const char *          site     = nullptr ) noexcept( false ) {
+        return getConnection( access, steady_clock_t::time_point::max( ), priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the cluster, waiting up to timeout
+       * @param access checkout access mode
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if no endpoint for the access mode is healthy
+       * @throws DBException if no connection became available before the timeout
+       */
+      Connection getConnection( Access                    access,
+                                std::chrono::milliseconds timeout,
+                                PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                const char *              site     = nullptr ) noexcept( false ) {
+        return getConnection( access, steady_clock_t::now( ) + timeout, priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the cluster
+       *
+       * READ_WRITE checkouts are served by the primary. READ_ONLY checkouts try the healthy
+       * replicas in routing order, then the primary, moving on to the next endpoint when a
+       * pool rejects or fails the checkout
+       * @param access checkout access mode
+       * @param deadline time to give up waiting for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if no endpoint for the access mode is healthy
+       * @throws DBException if no connection became available before the deadline
+       */
+      Connection getConnection( Access                     access,
+                                steady_clock_t::time_point deadline,
+                                PoolOptions::Priority      priority = PoolOptions::NORMAL,
+                                const char *               site     = nullptr ) noexcept( false ) {
+        return getConnection( access, 0, deadline, priority, site );
+      }
+
+      /**
+       * @brief Get a connection that observes an earlier commit, waiting up to timeout
+       * @param access checkout access mode
+       * @param position commit position to observe, 0 for any
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if no endpoint for the access mode is healthy
+       * @throws DBException if no connection became available before the timeout
+       */
+      Connection getConnection( Access                    access,
+                                uint64_t                  position,
+                                std::chrono::milliseconds timeout,
+                                PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                const char *              site     = nullptr ) noexcept( false ) {
+        return getConnection( access, position, steady_clock_t::now( ) + timeout, priority, site );
+      }
+
+      /**
+       * @brief Get a connection that observes an earlier commit
+       *
+       * READ_ONLY checkouts skip the replicas whose last known replay position is behind
+       * position, falling back to the primary; READ_WRITE checkouts always observe it
+       * @param access checkout access mode
+       * @param position commit position to observe, 0 for any
+       * @param deadline time to give up waiting for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if no endpoint for the access mode is healthy
+       * @throws DBException if no connection became available before the deadline
+       */
+      Connection getConnection( Access                     access,
+                                uint64_t                   position,
+                                steady_clock_t::time_point deadline,
+                                PoolOptions::Priority      priority = PoolOptions::NORMAL,
+                                const char *               site     = nullptr ) noexcept( false );
+
+     private:
+      /** Cluster endpoint and its pool */
+      struct Member {
+        Endpoint                      endpoint;
+        std::unique_ptr< Pool >       pool;
+        std::atomic< bool >           healthy{ false }; /**< Passed the last health check */
+        std::atomic< double >         latency{ 0 };     /**< Health check round trip average, microseconds */
+        std::atomic< uint64_t >       position{ 0 };    /**< Replay position at the last health check */
+        std::unique_ptr< Connection > probe;            /**< Health check connection, used by the running check */
+        std::future< bool >           check;            /**< Running health check */
+        steady_clock_t::duration      elapsed;          /**< Round trip of the last completed health check */
+      };
+
+      /**
+       * @brief Health check every endpoint concurrently; an endpoint whose check fails or
+       *        outlasts the health check deadline is marked down, and is not checked again
+       *        until its outstanding check returns
+       */
+      void checkHealth( );
+
+      /**
+       * @brief Health monitor: checks the endpoints every health check interval
+       */
+      void monitor( );
+
+      /**
+       * @brief Get the endpoints able to serve a checkout, in preference order
+       * @param access checkout access mode
+       * @param position commit position to observe, 0 for any
+       * @return healthy members
+       */
+      std::vector< Member * > route( Access access, uint64_t position );
+
+      ClusterOptions                           options;
+      std::vector< std::unique_ptr< Member > > members;
+      Member *                                 primary;
+      std::atomic< size_t >                    rotation;
+      std::mutex                               healthLock;
+      std::condition_variable                  healthWake;
+      bool                                     running;
+      std::thread                              healthMonitor;
+    };
+  } // namespace internal
+} // namespace dbcpp
+
+#endif
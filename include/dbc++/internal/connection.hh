@@ -3,8 +3,10 @@
 
 #include "../dbi/connection.hh"
 #include "statement.hh"
+#include "typed_query.hh"
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace dbcpp {
@@ -15,34 +17,81 @@ namespace dbcpp {
       using shared_cxn     = std::shared_ptr< connection_t >;
       using pool_release_f = std::function< void( shared_cxn ) >;
 
-      ~Connection( ) {
-        if ( poolRelease != nullptr ) {
-          poolRelease( connection );
-        }
-      }
-
       Connection( shared_cxn _connection, pool_release_f release = nullptr )
         : connection( std::move( _connection ) )
-        , poolRelease( release ) {}
+        , lease( release != nullptr ? std::make_shared< Lease >( connection, std::move( release ) ) : nullptr ) {}
 
       bool      connect( ) { return connection->connect( ); }
       bool      disconnect( ) { return connection->disconnect( ); }
       bool      reconnect( ) { return connection->reconnect( ); }
       bool      test( ) { return connection->test( ); }
+      bool      alive( ) { return connection->alive( ); }
       void      commit( ) { connection->commit( ); }
       void      rollback( ) { connection->rollback( ); }
+      uint64_t  commitPosition( ) const { return connection->commitPosition( ); }
+      bool      trackCommitPosition( bool track = true ) { return connection->trackCommitPosition( track ); }
+      uint64_t  replayPosition( ) { return connection->replayPosition( ); }
       void      setAutoCommit( bool ac = true ) { return connection->setAutoCommit( ac ); }
       Statement createStatement( std::string string ) const {
         auto notspace = []( const char &val ) -> bool { return !isspace( val ); };
         string.erase( string.begin( ), std::find_if( string.begin( ), string.end( ), notspace ) );
         string.erase( std::find_if( string.rbegin( ), string.rend( ), notspace ).base( ), string.end( ) );
-        return connection->createStatement( std::move( string ) );
+        return connection->prepareStatement( string );
       }
       Statement operator<<( const std::string &string ) const { return createStatement( string ); }
 
+      /**
+       * @brief Create a prepared statement for a typed query, with its parameters bound to
+       *        host variables of the query's types
+       * @param query typed query
+       * @return typed statement
+       */
+      template < typename... Args >
+      TypedStatement< Args... > createStatement( const TypedQuery< Args... > &query ) const {
+        return TypedStatement< Args... >( connection->prepareStatement( query.query( ) ) );
+      }
+
+      /**
+       * @brief Get the prepared statement cache of the underlying connection, which outlives
+       *        the lease when pooled
+       * @return statement cache
+       */
+      const interface::StatementCache &statementCache( ) const { return connection->statementCache( ); }
+
+      /**
+       * @brief Set a session parameter, skipping the round trip if it already has the value,
+       *        otherwise sending the change with the next statement (not by a commit); a
+       *        rollback undoes the changes sent in its transaction
+       * @param name parameter name, as the server reports it (e.g. "TimeZone")
+       * @param value parameter value
+       * @return true if set, false if the driver has no session parameters
+       */
+      bool setSessionParam( const std::string &name, const std::string &value ) {
+        return connection->setSessionParam( name, value );
+      }
+
+      /**
+       * @brief Get a session parameter, as last reported by the server or set on this connection
+       * @param name parameter name
+       * @return parameter value, empty if unknown
+       */
+      std::string sessionParam( const std::string &name ) { return connection->sessionParam( name ); }
+
      private:
-      shared_cxn     connection;
-      pool_release_f poolRelease;
+      /** Pool lease, shared by copies so the connection is released once, by the last copy */
+      struct Lease {
+        Lease( shared_cxn _connection, pool_release_f _release )
+          : connection( std::move( _connection ) )
+          , release( std::move( _release ) ) {}
+
+        ~Lease( ) { release( connection ); }
+
+        shared_cxn     connection;
+        pool_release_f release;
+      };
+
+      shared_cxn               connection;
+      std::shared_ptr< Lease > lease;
     };
   } // namespace internal
 } // namespace dbcpp
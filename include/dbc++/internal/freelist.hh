@@ -0,0 +1,101 @@
+#ifndef __DBCPP_INTERNAL_FREELIST_HH__
+#define __DBCPP_INTERNAL_FREELIST_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace dbcpp {
+  namespace internal {
+    /**
+     * Bounded, lock-free, multi-producer/multi-consumer stack of slot indices
+     *
+     * The head packs a 32 bit modification tag with the 32 bit top index so a
+     * pop racing an index being popped and pushed again (ABA) fails its CAS.
+     * Indices are handed out most recently pushed first.
+     */
+    class FreeList {
+      static const uint32_t NIL = UINT32_MAX;
+
+      static uint64_t pack( uint64_t tag, uint32_t index ) { return ( tag << 32 ) | index; }
+      static uint64_t tag( uint64_t head ) { return head >> 32; }
+      static uint32_t top( uint64_t head ) { return static_cast< uint32_t >( head ); }
+
+     public:
+      /**
+       * @brief Create an empty free list
+       * @param _capacity maximum index (exclusive) that may be stored
+       */
+      explicit FreeList( size_t _capacity )
+        : next( new std::atomic< uint32_t >[ _capacity ] )
+        , head( pack( 0, NIL ) )
+        , count( 0 )
+        , capacity( _capacity ) {
+        for ( size_t index = 0; index < capacity; ++index ) {
+          next[ index ].store( NIL, std::memory_order_relaxed );
+        }
+      }
+
+      FreeList( const FreeList & ) = delete;
+      FreeList &operator=( const FreeList & ) = delete;
+
+      /**
+       * @brief Add an index to the list
+       * @param index index to add, must not already be present
+       */
+      void push( size_t index ) {
+        uint64_t current = head.load( );
+        uint64_t desired = 0;
+
+        count.fetch_add( 1, std::memory_order_relaxed );
+
+        do {
+          next[ index ].store( top( current ), std::memory_order_relaxed );
+          desired = pack( tag( current ) + 1, static_cast< uint32_t >( index ) );
+        } while ( !head.compare_exchange_weak( current, desired ) );
+      }
+
+      /**
+       * @brief Remove the most recently added index from the list
+       * @param index removed index
+       * @return true if an index was removed, false if the list is empty
+       */
+      bool pop( size_t &index ) {
+        uint64_t current = head.load( );
+        uint64_t desired = 0;
+
+        do {
+          if ( top( current ) == NIL ) {
+            return false;
+          }
+
+          desired = pack( tag( current ) + 1, next[ top( current ) ].load( std::memory_order_relaxed ) );
+        } while ( !head.compare_exchange_weak( current, desired ) );
+
+        count.fetch_sub( 1, std::memory_order_relaxed );
+        index = top( current );
+        return true;
+      }
+
+      /**
+       * @brief Get the number of listed indices (may briefly over count under contention)
+       * @return index count
+       */
+      size_t size( ) const { return count.load( std::memory_order_relaxed ); }
+
+      /**
+       * @brief Identify if the list is (momentarily) empty
+       * @return true if empty, false if not
+       */
+      bool empty( ) const { return top( head.load( ) ) == NIL; }
+
+     private:
+      std::unique_ptr< std::atomic< uint32_t >[] > next;     /**< Per-index link to the next listed index */
+      std::atomic< uint64_t >                      head;     /**< Tagged top of stack */
+      std::atomic< size_t >                        count;    /**< Listed index count */
+      size_t                                       capacity; /**< Index bound */
+    };
+  } // namespace internal
+} // namespace dbcpp
+
+#endif
@@ -1,75 +1,1040 @@
 #ifndef __DBCPP_INTERNAL_POOL_HH__
 #define __DBCPP_INTERNAL_POOL_HH__
 
+#include "circuit_breaker.hh"
 #include "connection.hh"
+#include "freelist.hh"
+#include "pool_stats.hh"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
 #include <mutex>
 #include <queue>
+#include <random>
 #include <thread>
 
+#define DBCPP_STRINGIFY_( x ) #x
+#define DBCPP_STRINGIFY( x ) DBCPP_STRINGIFY_( x )
+
+/** Call site tag for Pool::getConnection lease tracking, e.g. "orders.cc:42" */
+#define DBCPP_CALL_SITE __FILE__ ":" DBCPP_STRINGIFY( __LINE__ )
+
 namespace dbcpp {
   namespace internal {
+    /** Database connection pool settings */
+    struct PoolOptions {
+      /** Connection validation performed on checkout */
+      enum Validation {
+        ALWAYS     = 0, /**< Test query on every checkout */
+        AFTER_IDLE = 1, /**< State check, plus a test query once idle past validationIdle */
+        NEVER      = 2, /**< No validation */
+        ON_ERROR   = 3, /**< State check on checkout and check-in, never a test query */
+      };
+
+      /** Checkout priority class */
+      enum Priority {
+        HIGH       = 0, /**< Latency critical, may use the reserved connections */
+        NORMAL     = 1, /**< Default */
+        LOW        = 2, /**< Background work, e.g. reporting */
+        PRIORITIES = 3, /**< Priority class count */
+      };
+
+      size_t                          minIdle        = 1;                          /**< Idle connections kept open */
+      size_t                          maxSize        = 10;                         /**< Maximum open connections */
+      bool                            autoCommit     = false;                      /**< Connection auto commit flag */
+      std::chrono::duration< double > checkPeriod    = std::chrono::minutes( 5 );  /**< Idle check/reap interval */
+      std::chrono::duration< double > idleTimeout    = std::chrono::minutes( 10 ); /**< Idle time before closing */
+      Validation                      validation     = AFTER_IDLE;                 /**< Checkout validation policy */
+      std::chrono::milliseconds       validationIdle = std::chrono::seconds( 1 );  /**< AFTER_IDLE test threshold */
+      std::chrono::milliseconds       connectTimeout = std::chrono::seconds( 30 ); /**< Concurrent connect deadline */
+      size_t                          statementCache = 32;                         /**< Per connection statements */
+      size_t                          affinityScan   = 4;                          /**< Idle cxns a hint searches */
+      size_t                          idleTests      = 2;                          /**< Idle cxns tested per check */
+      size_t                          maxWaiters     = 0;                          /**< Parked checkout limit */
+      size_t                          breakerLimit   = 5;                          /**< Failures opening the breaker */
+      std::chrono::milliseconds       breakerDelay   = std::chrono::seconds( 5 );  /**< Open breaker probe delay */
+      size_t                          reserved       = 0;                          /**< Connections kept for HIGH */
+      std::chrono::milliseconds       maxLifetime    = { };                        /**< Connection age limit, if set */
+      std::chrono::milliseconds       leakThreshold  = { };                        /**< Lease age reported, if set */
+      std::chrono::milliseconds       reclaimAfter   = { };                        /**< Lease age reclaimed, if set */
+      std::vector< std::string >      hotStatements  = { };                        /**< Prepared on every connect */
+      bool                            trackCommits   = false;                      /**< Capture commit positions */
+
+      /* A waiter gains one priority class per priorityAging waited, so low priority waiters are never starved */
+      std::chrono::milliseconds priorityAging = std::chrono::milliseconds( 100 ); /**< Wait worth one class */
+
+      /* Failed reconnects are retried with exponential, jittered, backoff */
+      std::chrono::milliseconds retryBackoff  = std::chrono::milliseconds( 100 ); /**< First retry delay */
+      std::chrono::milliseconds retryMaxDelay = std::chrono::seconds( 30 );       /**< Retry delay cap */
+    };
+
     /** Database connection pool */
     class Pool {
-      using connection_t = std::shared_ptr< interface::Connection >;
+      using connection_t   = std::shared_ptr< interface::Connection >;
+      using steady_clock_t = std::chrono::steady_clock;
+
+      /** Connection target, replaced as a whole by rebind( ) */
+      struct Binding {
+        std::unique_ptr< Uri > uri;      /**< Connection uri */
+        std::string            endpoint; /**< Endpoint description for logging */
+        uint64_t               epoch;    /**< Binding generation, counting from 1 */
+      };
+
+      using binding_t = std::shared_ptr< const Binding >;
+
+      /** Listing marks of a slot; a listed, unclaimed, slot holds its check-in time instead */
+      enum Listing : steady_clock_t::rep {
+        UNLISTED = 0,  /**< Not on the idle list */
+        CLAIMED  = -1, /**< On the idle list, held by the monitor; a checkout popping it passes it over */
+        BROKEN   = -2, /**< On the idle list, failed its idle test; the checkout popping it sends it to reconnect */
+        CLOSED   = -3, /**< On the idle list, closed past the idle timeout; the checkout popping it vacates it */
+      };
+
+      /** Pooled connection slot; owned by whoever removed its index from a list */
+      struct Slot {
+        connection_t               connection;   /**< Open connection, null (or reclaimed) while vacant */
+        steady_clock_t::time_point released;     /**< Time of the last check-in */
+        size_t                     attempts = 0; /**< Consecutive failed reconnect attempts */
+        uint64_t                   hits     = 0; /**< Statement cache hits already counted */
+        uint64_t                   misses   = 0; /**< Statement cache misses already counted */
+        PoolOptions::Priority      priority = PoolOptions::NORMAL; /**< Checkout priority of the lease */
+
+        /* Lifetime rotation; the monitor opens the successor, the slot owner swaps it in */
+        std::atomic< steady_clock_t::rep > expires{ 0 };      /**< Retirement time, 0 for none */
+        std::atomic< bool >                replaced{ false }; /**< Successor ready */
+        connection_t                       successor;         /**< Replacement connection, accessed atomically */
+
+        /* Rebinding; a connection of an earlier binding is rotated out like an expired one */
+        std::atomic< uint64_t > epoch{ 0 };       /**< Binding of the connection, 0 while vacant */
+        std::atomic< uint64_t > successorOf{ 0 }; /**< Binding of the successor */
+
+        /* Lease tracking; the lease ends once, by check-in or reclaim, advancing the generation */
+        std::atomic< steady_clock_t::rep > leased{ 0 };        /**< Time of the checkout, 0 when not leased */
+        std::atomic< uint64_t >            generation{ 0 };    /**< Lease generation */
+        std::atomic< const char * >        site{ nullptr };    /**< Checkout call site tag */
+        std::atomic< bool >                reported{ false };  /**< Lease reported past the leak threshold */
+
+        /* Idle listing; the monitor claims a listed connection in place, leaving the idle list undisturbed */
+        std::atomic< steady_clock_t::rep > listed{ UNLISTED }; /**< Check-in time while listed, or a Listing mark */
+      };
+
+      /** Scheduled reconnect attempt */
+      struct Retry {
+        steady_clock_t::time_point due;   /**< Time to attempt the reconnect */
+        size_t                     index; /**< Slot index */
+
+        bool operator>( const Retry &other ) const { return due > other.due; }
+      };
+
+      using retry_queue_t = std::priority_queue< Retry, std::vector< Retry >, std::greater< Retry > >;
+
+      /** Most idle connections a hinted checkout searches, whatever affinityScan is */
+      static const size_t AFFINITY_SCAN_LIMIT = 16;
+
+      /** Pool activity counters and gauges, updated without locks */
+      struct Metrics {
+        std::atomic< uint64_t > checkouts{ 0 };
+        std::atomic< uint64_t > waits{ 0 };
+        std::atomic< uint64_t > timeouts{ 0 };
+        std::atomic< uint64_t > validationFailures{ 0 };
+        std::atomic< uint64_t > reconnects{ 0 };
+        std::atomic< uint64_t > reconnectFailures{ 0 };
+        std::atomic< uint64_t > opened{ 0 };
+        std::atomic< uint64_t > closed{ 0 };
+        std::atomic< uint64_t > statementHits{ 0 };
+        std::atomic< uint64_t > statementMisses{ 0 };
+        std::atomic< uint64_t > affinityHits{ 0 };
+        std::atomic< uint64_t > affinityMisses{ 0 };
+        std::atomic< uint64_t > rejections{ 0 };
+        std::atomic< uint64_t > retired{ 0 };
+        std::atomic< uint64_t > leaks{ 0 };
+        std::atomic< uint64_t > reclaimed{ 0 };
+        std::atomic< size_t >   leased{ 0 };
+        std::atomic< size_t >   broken{ 0 };
+        Histogram               waitTime;
+        Histogram               leaseTime;
+        Histogram               reconnectTime;
+        Histogram               classWaitTime[ PoolOptions::PRIORITIES ];
+        std::atomic< uint64_t > classTimeouts[ PoolOptions::PRIORITIES ];
+
+        Metrics( ) {
+          for ( auto &&count : classTimeouts ) {
+            count.store( 0, std::memory_order_relaxed );
+          }
+        }
+      };
+
+      /** Checkout waiter, parked until a released connection is handed to it */
+      struct Waiter {
+        std::condition_variable    ready;
+        size_t                     index    = 0;
+        bool                       assigned = false;
+        bool                       async    = false;
+        PoolOptions::Priority      priority = PoolOptions::NORMAL;
+        steady_clock_t::time_point enqueued;
+      };
+
+     public:
+      /**
+       * Asynchronous checkout completion handler; given the leased connection, or the
+       * checkout failure (timeout, cancellation, rejection or connection error)
+       */
+      using checkout_handler_f = std::function< void( std::exception_ptr, Connection ) >;
+
+     private:
+      /** Asynchronous checkout; parked like a waiter, but completed by whoever frees its slot */
+      struct AsyncWaiter : public Waiter {
+        checkout_handler_f             handler;
+        const char *                   site = nullptr;
+        steady_clock_t::time_point     start;
+        steady_clock_t::time_point     deadline;
+        std::shared_ptr< AsyncWaiter > self;          /**< Keeps the waiter alive while parked */
+        bool                           probe = false; /**< Admitted as the half open breaker's probe */
+      };
+
+      using async_list_t = std::vector< AsyncWaiter * >;
+
+      connection_t create( const Binding &target );
+      connection_t connect( const Binding &target );
+
+      /**
+       * @brief Create a connection target
+       * @param uri connection uri
+       * @param epoch binding generation
+       * @return connection target
+       */
+      static binding_t bind( const std::string &uri, uint64_t epoch );
 
-      connection_t connect( );
+      static PoolOptions fixedSize( size_t count, bool autoCommit, std::chrono::duration< double > checkPeriod ) {
+        PoolOptions options;
 
-      static void addIndex( size_t index, std::queue< size_t > &queue, std::mutex &lock ) {
-        std::lock_guard< std::mutex > guard( lock );
-        queue.push( index );
+        options.minIdle     = count;
+        options.maxSize     = count;
+        options.autoCommit  = autoCommit;
+        options.checkPeriod = checkPeriod;
+
+        return options;
       }
 
-      static bool getNextIndex( size_t &index, std::queue< size_t > &queue, std::mutex &lock ) {
-        std::lock_guard< std::mutex > guard( lock );
+      /**
+       * @brief Claim a connection for a checkout class; all but HIGH are limited to the
+       *        unreserved connections
+       * @param priority checkout priority
+       * @return true if claimed, false if the unreserved connections are all leased
+       */
+      bool claim( PoolOptions::Priority priority ) {
+        if ( ( priority == PoolOptions::HIGH ) || !options.reserved ) {
+          return true;
+        }
+
+        auto limit   = slots.size( ) - options.reserved;
+        auto current = unreserved.load( );
 
-        if ( queue.empty( ) ) {
+        do {
+          if ( current >= limit ) {
+            return false;
+          }
+        } while ( !unreserved.compare_exchange_weak( current, current + 1 ) );
+
+        return true;
+      }
+
+      /**
+       * @brief Return a claim made by claim( )
+       * @param priority checkout priority
+       */
+      void unclaim( PoolOptions::Priority priority ) {
+        if ( ( priority != PoolOptions::HIGH ) && options.reserved ) {
+          unreserved.fetch_sub( 1 );
+        }
+      }
+
+      /**
+       * @brief Take the most recently used idle connection, passing over those the monitor
+       *        holds and disposing of those it failed or closed in place
+       * @param index slot index
+       * @return true if an idle connection was taken, false if none are idle
+       */
+      bool popIdle( size_t &index ) {
+        while ( queue.pop( index ) ) {
+          switch ( slots[ index ].listed.exchange( UNLISTED ) ) {
+            case CLAIMED:
+              break; // The monitor returns it once done
+            case BROKEN:
+              stale.fetch_sub( 1 );
+              addReconnectIndex( index );
+              break;
+            case CLOSED:
+              stale.fetch_sub( 1 );
+              vacant.push( index ); // Taken from there by our caller, should the idle list run dry
+              break;
+            default:
+              return true;
+          }
+        }
+
+        return false;
+      }
+
+      /**
+       * @brief Take the idle connection with a query's statement cached, from the
+       *        affinityScan most recently used, otherwise the most recently used
+       * @param index slot index
+       * @param hint query string
+       * @return true if an idle connection was taken, false if none are idle
+       */
+      bool takeAffineIndex( size_t &index, const std::string &hint ) {
+        size_t scanned[ AFFINITY_SCAN_LIMIT ];
+        size_t limit = options.affinityScan;
+        size_t count = 0;
+        bool   found = false;
+
+        if ( limit > AFFINITY_SCAN_LIMIT ) {
+          limit = AFFINITY_SCAN_LIMIT;
+        }
+
+        /* Popped indices are ours alone, so their statement caches may be inspected */
+        while ( !found && ( ( count == 0 ) || ( count < limit ) ) && popIdle( scanned[ count ] ) ) {
+          auto &slot = slots[ scanned[ count++ ] ];
+
+          found = slot.connection && slot.connection->statementCache( ).contains( hint );
+        }
+
+        if ( count == 0 ) {
           return false;
         }
 
-        index = queue.front( );
-        queue.pop( );
+        index = scanned[ found ? count - 1 : 0 ];
 
+        /* The passed over connections go back in their order, most recently used on top */
+        for ( auto num = count; num-- > 0; ) {
+          if ( scanned[ num ] != index ) {
+            release( queue, scanned[ num ] );
+          }
+        }
+
+        ( found ? metrics.affinityHits : metrics.affinityMisses ).fetch_add( 1, std::memory_order_relaxed );
         return true;
       }
 
-      void addConnectionIndex( size_t index ) { addIndex( index, queue, queueLock ); }
-      void addReconnectIndex( size_t index ) { addIndex( index, reconnect, reconnectLock ); }
+      /**
+       * @brief Take a slot for checkout: the most recently used idle connection (or, given
+       *        a hint, one with the hinted statement cached), or a vacant slot to open a new
+       *        connection in
+       * @param index slot index
+       * @param priority checkout priority
+       * @param hint query string the checkout will prepare, null for none
+       * @return true if a slot was taken, false if the pool is exhausted for the priority
+       */
+      bool takeIndex( size_t &index, PoolOptions::Priority priority, const std::string *hint = nullptr ) {
+        if ( !claim( priority ) ) {
+          return false;
+        }
 
-      void addConnection( connection_t connection ) {
-        auto found = std::find( connections.begin( ), connections.end( ), connection );
+        if ( hint ? takeAffineIndex( index, *hint ) : popIdle( index ) ) {
+          return true;
+        }
 
-        if ( found != connections.end( ) ) {
-          addConnectionIndex( static_cast< size_t >( connections.end( ) - found - 1 ) );
+        if ( vacant.pop( index ) ) {
+          if ( hint ) {
+            metrics.affinityMisses.fetch_add( 1, std::memory_order_relaxed );
+          }
+
+          return true;
         }
+
+        unclaim( priority );
+        return false;
       }
 
-      void addReconnect( connection_t connection ) {
-        auto found = std::find( connections.begin( ), connections.end( ), connection );
+      /**
+       * @brief Get the serving rank of a waiter: its arrival time, deferred by priorityAging
+       *        per class below HIGH; lowest is served first
+       * @param waiter parked waiter
+       * @return rank
+       */
+      steady_clock_t::time_point rank( const Waiter *waiter ) const {
+        return waiter->enqueued + options.priorityAging * static_cast< int >( waiter->priority );
+      }
 
-        if ( found != connections.end( ) ) {
-          addReconnectIndex( static_cast< size_t >( connections.end( ) - found - 1 ) );
+      /**
+       * @brief Hand free slot indices to parked waiters, by priority and then age
+       * @note queueLock must be held
+       */
+      void dispatchWaiters( ) {
+        size_t index = 0;
+
+        while ( waiting.load( ) ) {
+          std::deque< Waiter * > *classes[ PoolOptions::PRIORITIES ];
+          size_t                  count = 0;
+
+          for ( auto &&waiters : this->waiters ) {
+            if ( !waiters.empty( ) ) {
+              classes[ count++ ] = &waiters;
+            }
+          }
+
+          std::sort( classes, classes + count, [ this ]( std::deque< Waiter * > *lhs, std::deque< Waiter * > *rhs ) {
+            return rank( lhs->front( ) ) < rank( rhs->front( ) );
+          } );
+
+          /* Best ranked waiter first, skipping those whose class may not take a connection */
+          auto served = std::find_if( classes, classes + count, [ this, &index ]( std::deque< Waiter * > *waiters ) {
+            return takeIndex( index, waiters->front( )->priority );
+          } );
+
+          if ( served == classes + count ) {
+            break;
+          }
+
+          auto waiter = ( *served )->front( );
+          ( *served )->pop_front( );
+          waiting.fetch_sub( 1 );
+
+          waiter->index    = index;
+          waiter->assigned = true;
+
+          if ( waiter->async ) {
+            assigned.push_back( static_cast< AsyncWaiter * >( waiter ) );
+          } else {
+            waiter->ready.notify_one( );
+          }
         }
       }
 
-      connection_t getNextConnection( std::queue< size_t > &queue, std::mutex &lock ) {
-        size_t index = 0;
+      /**
+       * @brief Hand free slot indices to parked waiters, then complete the asynchronous
+       *        checkouts handed a slot, outside the waiter lock
+       */
+      void serveWaiters( ) {
+        async_list_t ready;
+
+        {
+          std::lock_guard< std::mutex > guard( queueLock );
+          dispatchWaiters( );
+          ready.swap( assigned );
+        }
+
+        completeAsync( ready );
+      }
+
+      /**
+       * @brief Return a checkout's claim on the unreserved connections, serving any parked
+       *        waiter it was holding back
+       * @param priority checkout priority
+       */
+      void returnClaim( PoolOptions::Priority priority ) {
+        if ( ( priority != PoolOptions::HIGH ) && options.reserved ) {
+          unclaim( priority );
+
+          if ( waiting.load( ) > 0 ) {
+            serveWaiters( );
+          }
+        }
+      }
+
+      /**
+       * @brief Return a slot index to a free list
+       *
+       * The index is pushed onto the lock-free list; the waiter lock is only taken when
+       * a checkout is parked, in which case the oldest waiter is handed a slot. An idle
+       * index is listed at its check-in time.
+       * @param list idle or vacant list
+       * @param index slot index
+       */
+      void release( FreeList &list, size_t index ) {
+        if ( &list == &queue ) {
+          slots[ index ].listed.store( slots[ index ].released.time_since_epoch( ).count( ) );
+        }
+
+        list.push( index );
+
+        if ( waiting.load( ) > 0 ) {
+          serveWaiters( );
+        }
+      }
+
+      /**
+       * @brief Return a connection index to the pool
+       * @param index slot index
+       */
+      void addConnectionIndex( size_t index ) {
+        slots[ index ].released = steady_clock_t::now( );
+        release( queue, index );
+      }
+
+      /**
+       * @brief End a lease, unless it was already ended by a reclaim
+       * @param index slot index
+       * @param generation lease generation
+       * @return true if ended, false if not
+       */
+      bool endLease( size_t index, uint64_t generation ) {
+        auto &slot = slots[ index ];
+
+        if ( !slot.generation.compare_exchange_strong( generation, generation + 1 ) ) {
+          return false;
+        }
+
+        auto leased = steady_clock_t::duration( slot.leased.exchange( 0 ) );
+
+        metrics.leaseTime.record( steady_clock_t::now( ).time_since_epoch( ) - leased );
+
+        if ( ( metrics.leased.fetch_sub( 1 ) == 1 ) && draining.load( ) ) {
+          std::lock_guard< std::mutex > guard( queueLock );
+          drained.notify_all( );
+        }
+
+        returnClaim( slot.priority );
+        return true;
+      }
+
+      /**
+       * @brief Return a leased connection to the pool, or to the reconnect queue if its state
+       *        shows it failed while leased
+       * @param index slot index
+       * @param generation lease generation
+       * @param connection leased connection
+       */
+      void checkIn( size_t index, uint64_t generation, connection_t connection ) {
+        auto &slot  = slots[ index ];
+        auto &cache = connection->statementCache( );
+
+        if ( !endLease( index, generation ) ) {
+          /* Reclaimed while leased; the orphaned connection is closed now its holder is done */
+          close( connection );
+          return;
+        }
+
+        metrics.statementHits.fetch_add( cache.hits( ) - slot.hits, std::memory_order_relaxed );
+        metrics.statementMisses.fetch_add( cache.misses( ) - slot.misses, std::memory_order_relaxed );
+        slot.hits   = cache.hits( );
+        slot.misses = cache.misses( );
+
+        rotate( index );
+
+        if ( ( options.validation != PoolOptions::NEVER ) && !slot.connection->alive( ) ) {
+          metrics.validationFailures.fetch_add( 1, std::memory_order_relaxed );
+          addReconnectIndex( index );
+        } else {
+          addConnectionIndex( index );
+        }
+      }
+
+      /** Outcome of a checkout validation */
+      enum Validity {
+        INVALID = 0, /**< Not to be leased */
+        VALID   = 1, /**< May be leased, per the client side state alone */
+        TESTED  = 2, /**< May be leased, per a test query answered by the server */
+      };
+
+      /**
+       * @brief Validate an idle connection for checkout, per the validation policy
+       * @param slot connection slot
+       * @param probe true to run a test query whatever the policy, the checkout being the
+       *        breaker's probe
+       * @return validation outcome
+       */
+      Validity validate( Slot &slot, bool probe ) {
+        auto test = [ &slot ]( ) { return slot.connection->test( ) ? TESTED : INVALID; };
+
+        if ( probe ) {
+          return test( );
+        }
+
+        switch ( options.validation ) {
+          case PoolOptions::NEVER:
+            return VALID;
+          case PoolOptions::ALWAYS:
+            return test( );
+          case PoolOptions::AFTER_IDLE:
+            if ( steady_clock_t::now( ) - slot.released >= options.validationIdle ) {
+              return test( );
+            }
+            return slot.connection->alive( ) ? VALID : INVALID;
+          case PoolOptions::ON_ERROR:
+          default:
+            return slot.connection->alive( ) ? VALID : INVALID;
+        }
+      }
+
+      /**
+       * @brief Schedule the retirement of a slot's newly (re)opened connection at its maximum
+       *        lifetime, less up to an eighth of it so connections opened together retire apart
+       * @param index slot index
+       */
+      void scheduleRetirement( size_t index ) {
+        if ( options.maxLifetime.count( ) <= 0 ) {
+          return;
+        }
+
+        auto             now      = steady_clock_t::now( );
+        auto             lifetime = std::chrono::duration_cast< steady_clock_t::duration >( options.maxLifetime );
+        std::minstd_rand generator( static_cast< uint32_t >( now.time_since_epoch( ).count( ) ^ index ) );
+        std::uniform_int_distribution< steady_clock_t::rep > jitter( 0, lifetime.count( ) / 8 );
+
+        slots[ index ].expires.store( ( now + lifetime ).time_since_epoch( ).count( ) - jitter( generator ) );
+        wakeMonitor( );
+      }
+
+      /**
+       * @brief Wake the monitor to reconsider its next deadline
+       */
+      void wakeMonitor( ) {
+        /* Taking the lock orders the notification after any deadline computation in progress */
+        std::unique_lock< std::mutex > guard( reconnectLock );
+
+        guard.unlock( );
+        monitorWake.notify_one( );
+      }
+
+      /**
+       * @brief Place a newly opened connection in a slot
+       * @param index slot index
+       * @param connection open connection
+       * @param epoch binding the connection was opened for
+       */
+      void install( size_t index, connection_t connection, uint64_t epoch ) {
+        slots[ index ].connection = std::move( connection );
+        slots[ index ].hits       = 0;
+        slots[ index ].misses     = 0;
+        slots[ index ].epoch.store( epoch );
+        scheduleRetirement( index );
+
+        /* Opened for a binding replaced meanwhile; retire it at once */
+        if ( epoch != std::atomic_load( &binding )->epoch ) {
+          slots[ index ].expires.store( 1 );
+          wakeMonitor( );
+        }
+      }
+
+      /**
+       * @brief Close a retired or unwanted connection
+       * @param connection open connection
+       */
+      void close( connection_t connection ) {
+        connection->statementCache( ).clear( );
+        connection->disconnect( );
+        metrics.closed.fetch_add( 1, std::memory_order_relaxed );
+      }
+
+      /**
+       * @brief Swap a slot's connection for its successor, when one is ready, closing the
+       *        retired connection
+       * @param index slot index, owned by the caller
+       * @return true if the connection was replaced, false if not
+       */
+      bool rotate( size_t index ) {
+        auto &slot = slots[ index ];
+
+        if ( !slot.replaced.load( std::memory_order_acquire ) ) {
+          return false;
+        }
+
+        auto successor = std::atomic_exchange( &slot.successor, connection_t( ) );
+
+        slot.replaced.store( false );
+
+        if ( !successor ) {
+          return false;
+        }
+
+        if ( auto retiring = std::move( slot.connection ) ) {
+          close( retiring );
+          metrics.retired.fetch_add( 1, std::memory_order_relaxed );
+        } else {
+          open.fetch_add( 1 );
+        }
+
+        install( index, std::move( successor ), slot.successorOf.load( ) );
+        return true;
+      }
+
+      /**
+       * @brief Close a slot's connection, leaving the slot vacant
+       * @param index slot index
+       * @param orphan false to close the connection, true to leave it to the holder of a reclaimed
+       *        lease; the slot keeps it until the vacancy is filled
+       */
+      void vacate( size_t index, bool orphan = false ) {
+        auto &slot = slots[ index ];
+
+        slot.expires.store( 0 );
+        slot.epoch.store( 0 );
+
+        if ( orphan ) {
+          open.fetch_sub( 1 );
+        } else if ( auto connection = std::move( slot.connection ) ) {
+          close( connection );
+          open.fetch_sub( 1 );
+        }
+
+        if ( slot.replaced.exchange( false ) ) {
+          if ( auto successor = std::atomic_exchange( &slot.successor, connection_t( ) ) ) {
+            close( successor );
+          }
+        }
+      }
+
+      /**
+       * @brief Close a slot's connection and return the slot for reuse
+       * @param index slot index
+       * @param orphan as for vacate( )
+       */
+      void addVacantIndex( size_t index, bool orphan = false ) {
+        vacate( index, orphan );
+        release( vacant, index );
+      }
+
+      /**
+       * @brief Settle an idle connection claimed by the monitor: leave it listed, marked with
+       *        the outcome for the checkout popping it, or, if one popped it meanwhile, return it
+       * @param index slot index
+       * @param outcome check-in time to stay idle, BROKEN to reconnect, CLOSED once vacated
+       */
+      void settle( size_t index, steady_clock_t::rep outcome ) {
+        steady_clock_t::rep claimed = CLAIMED;
+
+        if ( outcome < 0 ) {
+          stale.fetch_add( 1 );
+        }
+
+        if ( slots[ index ].listed.compare_exchange_strong( claimed, outcome ) ) {
+          return;
+        }
+
+        /* Popped and passed over; the index is ours again */
+        if ( outcome < 0 ) {
+          stale.fetch_sub( 1 );
+        }
+
+        if ( outcome == BROKEN ) {
+          addReconnectIndex( index );
+        } else if ( outcome == CLOSED ) {
+          release( vacant, index );
+        } else {
+          release( queue, index );
+        }
+      }
+
+      /**
+       * @brief Get the next available slot index, waiting for one to be returned
+       * @param index slot index
+       * @param deadline time to give up waiting
+       * @param priority checkout priority
+       * @param hint query string the checkout will prepare, null for none; only considered
+       *        when a connection is taken without waiting
+       * @return true if an index was acquired, false if the deadline expired
+       * @throws PoolUnavailable if the waiter limit is reached
+       */
+      bool waitNextIndex( size_t &                   index,
+                          steady_clock_t::time_point deadline,
+                          PoolOptions::Priority      priority,
+                          const std::string *        hint = nullptr ) {
+        if ( ( waiting.load( ) == 0 ) && takeIndex( index, priority, hint ) ) {
+          return true;
+        }
+
+        std::unique_lock< std::mutex > guard( queueLock );
+        Waiter                         waiter;
+        auto &                         waiters = this->waiters[ priority ];
+
+        waiter.priority = priority;
+        waiter.enqueued = steady_clock_t::now( );
+
+        /* Anything released now goes to the waiters ahead of us anyway */
+        if ( options.maxWaiters && ( waiting.load( ) >= options.maxWaiters ) ) {
+          metrics.rejections.fetch_add( 1, std::memory_order_relaxed );
+          throw PoolUnavailable( "Connection pool waiter limit reached" );
+        }
+
+        waiters.push_back( &waiter );
+        waiting.fetch_add( 1 );
+        metrics.waits.fetch_add( 1, std::memory_order_relaxed );
+
+        /* Anything released before we were counted as waiting is picked up here */
+        dispatchWaiters( );
+
+        if ( !assigned.empty( ) ) {
+          async_list_t ready;
+
+          ready.swap( assigned );
+          guard.unlock( );
+          completeAsync( ready );
+          guard.lock( );
+        }
+
+        if ( !waiter.ready.wait_until( guard, deadline, [ this, &waiter ]( ) {
+               return waiter.assigned || draining.load( );
+             } ) ||
+             !waiter.assigned ) {
+          waiters.erase( std::find( waiters.begin( ), waiters.end( ), &waiter ) );
+          waiting.fetch_sub( 1 );
+
+          if ( draining.load( ) ) {
+            throw PoolUnavailable( "Connection pool is draining" );
+          }
+
+          return false;
+        }
+
+        index = waiter.index;
+        return true;
+      }
+
+      /**
+       * @brief Schedule a broken connection for reconnection, waking the monitor
+       * @param index slot index
+       * @param delay time to wait before the attempt
+       */
+      void addReconnectIndex( size_t index, steady_clock_t::duration delay = steady_clock_t::duration::zero( ) ) {
+        metrics.broken.fetch_add( 1, std::memory_order_relaxed );
+
+        {
+          std::lock_guard< std::mutex > guard( reconnectLock );
+          reconnect.push( Retry{ steady_clock_t::now( ) + delay, index } );
+        }
+
+        monitorWake.notify_one( );
+      }
 
-        if ( !getNextIndex( index, queue, lock ) ) {
-          return nullptr;
+      /**
+       * @brief Get the next connection due for reconnection
+       * @param index slot index
+       * @param now current time
+       * @note reconnectLock must be held
+       * @return true if an index was due, false if not
+       */
+      bool getReconnectIndex( size_t &index, steady_clock_t::time_point now ) {
+        if ( reconnect.empty( ) || ( reconnect.top( ).due > now ) ) {
+          return false;
         }
 
-        return connections[ index ];
+        index = reconnect.top( ).index;
+        reconnect.pop( );
+        metrics.broken.fetch_sub( 1, std::memory_order_relaxed );
+
+        return true;
+      }
+
+      /**
+       * @brief Get the delay before retrying a failed reconnect: exponential in the failed
+       *        attempt count, capped, with the upper half randomized so a pool's broken
+       *        connections (and pools sharing a server) do not retry in lock step
+       * @param attempts consecutive failed attempts
+       * @return retry delay
+       */
+      steady_clock_t::duration retryDelay( size_t attempts ) {
+        auto limit = std::chrono::duration_cast< steady_clock_t::duration >( options.retryMaxDelay );
+        auto delay = std::chrono::duration_cast< steady_clock_t::duration >( options.retryBackoff );
+
+        for ( size_t attempt = 1; ( attempt < attempts ) && ( delay < limit ); ++attempt ) {
+          delay *= 2;
+        }
+
+        delay = std::min( delay, limit );
+
+        std::uniform_int_distribution< steady_clock_t::rep > jitter( 0, delay.count( ) / 2 );
+
+        return delay - steady_clock_t::duration( jitter( random ) );
+      }
+
+      /**
+       * @brief Pool monitor: sleeps until the next idle check or scheduled reconnect
+       * @param endpoint endpoint description for logging
+       */
+      void monitor( std::string endpoint );
+
+      /**
+       * @brief Discard the successors opened for an earlier binding, and schedule the
+       *        connections of an earlier binding for replacement
+       * @param epoch current binding
+       */
+      void retireBinding( uint64_t epoch );
+
+      /**
+       * @brief Get the earliest retirement time of the connections without a successor
+       * @return retirement time, time_point::max( ) if none
+       */
+      steady_clock_t::time_point nextRetirement( ) const {
+        auto next = steady_clock_t::time_point::max( );
+
+        for ( auto &&slot : slots ) {
+          auto expires = slot.expires.load( std::memory_order_relaxed );
+
+          if ( expires && !slot.replaced.load( std::memory_order_relaxed ) ) {
+            next = std::min( next, steady_clock_t::time_point( steady_clock_t::duration( expires ) ) );
+          }
+        }
+
+        return next;
+      }
+
+      /**
+       * @brief Open successors, concurrently, for the connections past their retirement time
+       * @param now current time
+       * @param endpoint endpoint description for logging
+       */
+      void replaceExpired( steady_clock_t::time_point now, const std::string &endpoint );
+
+      /**
+       * @brief Reconnect broken connections concurrently, rescheduling failures with backoff
+       * @param broken slot indices
+       * @param endpoint endpoint description for logging
+       */
+      void reconnectIndices( const std::vector< size_t > &broken, const std::string &endpoint );
+
+      /**
+       * @brief Pass a checkout through the drain state and the circuit breaker
+       * @param probe set if the checkout was admitted as the breaker's probe
+       * @throws PoolUnavailable if the pool is draining or the breaker is open
+       */
+      void admit( bool &probe ) {
+        if ( draining.load( ) ) {
+          metrics.rejections.fetch_add( 1, std::memory_order_relaxed );
+          throw PoolUnavailable( "Connection pool is draining" );
+        }
+
+        if ( !breaker.admit( probe ) ) {
+          metrics.rejections.fetch_add( 1, std::memory_order_relaxed );
+          throw PoolUnavailable( "Connection pool circuit breaker is open" );
+        }
+      }
+
+      /**
+       * @brief Open a connection in a vacant slot
+       * @param index slot index
+       * @throws DBException, returning the slot, if the connection can not be established
+       */
+      void openIndex( size_t index );
+
+      /**
+       * @brief Lease a slot taken for checkout, opening or validating its connection
+       * @param index slot index, claimed for the priority
+       * @param priority checkout priority
+       * @param site checkout call site tag
+       * @param start time the checkout was requested
+       * @param connection leased connection, set if leased
+       * @param probe whether the checkout holds the breaker's probe; cleared once a connect or
+       *        test query settles it
+       * @return true if leased, false if validation failed and the slot went to reconnect
+       * @throws DBException, returning the slot, if a new connection can not be established
+       */
+      bool checkout( size_t                     index,
+                     PoolOptions::Priority      priority,
+                     const char *               site,
+                     steady_clock_t::time_point start,
+                     Connection &               connection,
+                     bool &                     probe );
+
+      /**
+       * @brief Get a connection from the pool, waiting up to a deadline
+       * @param hint query string the checkout will prepare, null for none
+       * @param deadline time to give up waiting for a connection
+       * @param priority checkout priority
+       * @param site call site tag reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if the checkout was rejected without waiting
+       * @throws DBException if no connection became available before the deadline
+       */
+      Connection acquire( const std::string *        hint,
+                          steady_clock_t::time_point deadline,
+                          PoolOptions::Priority      priority,
+                          const char *               site );
+
+      /**
+       * @brief Start an asynchronous checkout: complete it now if a slot is free, otherwise
+       *        park it until a slot is handed to it or its deadline expires
+       * @param waiter asynchronous checkout
+       */
+      void submitAsync( std::shared_ptr< AsyncWaiter > waiter );
+
+      /**
+       * @brief Complete the asynchronous checkouts that were handed a slot
+       * @param ready asynchronous checkouts, assigned a slot index
+       */
+      void completeAsync( const async_list_t &ready );
+
+      /**
+       * @brief Lease an asynchronous checkout's slot and pass the connection to its handler,
+       *        resubmitting the checkout if the slot's connection fails validation
+       * @param waiter asynchronous checkout, assigned a slot index
+       */
+      void finishAsync( std::shared_ptr< AsyncWaiter > waiter );
+
+      /**
+       * @brief Fail an asynchronous checkout, passing the error to its handler
+       * @param waiter asynchronous checkout
+       * @param error checkout failure
+       */
+      void failAsync( const std::shared_ptr< AsyncWaiter > &waiter, std::exception_ptr error );
+
+      /**
+       * @brief Fail the parked asynchronous checkouts past their deadline
+       * @param now current time
+       */
+      void expireAsync( steady_clock_t::time_point now );
+
+      /**
+       * @brief Cancel a parked asynchronous checkout
+       * @param waiter asynchronous checkout
+       * @return true if cancelled, false if it was already handed a slot or completed
+       */
+      bool cancelAsync( AsyncWaiter *waiter );
+
+      /**
+       * @brief Create the lease handle for a checked out connection
+       * @param index slot index
+       * @param priority checkout priority
+       * @param site checkout call site tag
+       * @return leased connection, returned to the pool by index when released
+       */
+      Connection lease( size_t index, PoolOptions::Priority priority, const char *site ) {
+        auto &slot       = slots[ index ];
+        auto  generation = slot.generation.load( );
+        auto  connection = slot.connection; // Before the lease is published, and so may be reclaimed
+
+        slot.priority = priority;
+        slot.site.store( site, std::memory_order_relaxed );
+        slot.reported.store( false, std::memory_order_relaxed );
+        slot.leased.store( steady_clock_t::now( ).time_since_epoch( ).count( ) );
+        metrics.leased.fetch_add( 1, std::memory_order_relaxed );
+        metrics.checkouts.fetch_add( 1, std::memory_order_relaxed );
+
+        return Connection( std::move( connection ), [ this, index, generation ]( connection_t connection ) {
+          checkIn( index, generation, std::move( connection ) );
+        } );
       }
 
-     protected:
-      void add( connection_t connection ) { addConnection( connection ); }
+      /**
+       * @brief Report leases held past the leak threshold, and reclaim those held past the
+       *        reclaim threshold
+       * @param now current time
+       */
+      void checkLeases( steady_clock_t::time_point now );
+
+      /**
+       * @brief Test the idleTests least recently used idle connections concurrently, in place on
+       *        the idle list, closing those idle past the timeout while keeping the minimum idle
+       *        count, and open connections up to the minimum idle count
+       */
+      void checkIdle( );
 
      public:
+      Pool( const std::string &uri, const PoolOptions &options );
+
+      Pool( Uri *uri, const PoolOptions &options )
+        : Pool( *uri, options ) {}
+
       Pool( const std::string &             uri,
             size_t                          count       = 10,
-            bool                            _autoCommit = false,
-            std::chrono::duration< double > checkPeriod = std::chrono::minutes( 5 ) );
+            bool                            autoCommit  = false,
+            std::chrono::duration< double > checkPeriod = std::chrono::minutes( 5 ) )
+        : Pool( uri, fixedSize( count, autoCommit, checkPeriod ) ) {}
 
       Pool( Uri *                           uri,
             size_t                          count       = 10,
@@ -78,56 +1043,344 @@ namespace dbcpp {
         : Pool( *uri, count, autoCommit, checkPeriod ) {}
 
       ~Pool( ) {
-        asyncTestRunning = false;
+        {
+          std::lock_guard< std::mutex > guard( reconnectLock );
+          asyncTestRunning = false;
+        }
+
+        monitorWake.notify_one( );
         asyncTest.join( );
+
+        /* Parked asynchronous checkouts can no longer be served */
+        expireAsync( steady_clock_t::time_point::max( ) );
+
+        /* Cached statements reference their connection */
+        for ( auto &&slot : slots ) {
+          if ( slot.connection ) {
+            slot.connection->statementCache( ).clear( );
+          }
+        }
       }
 
       /**
        * @brief Sets the automatic commit flag for the pool connections
        * @param ac true for automatic commit, false to disable
        */
-      void setAutoCommit( bool ac = true ) { autoCommit = ac; };
+      void setAutoCommit( bool ac = true ) { options.autoCommit = ac; };
+
+      /**
+       * @brief Get the number of open connections, leased or idle
+       * @return open connection count
+       */
+      size_t size( ) const { return open.load( ); }
+
+      /**
+       * @brief Get the number of idle connections
+       * @return idle connection count
+       */
+      size_t idle( ) const {
+        auto listed = queue.size( );
+        auto dead   = stale.load( );
+
+        return listed > dead ? listed - dead : 0;
+      }
+
+      /**
+       * @brief Get the number of leased connections
+       * @return leased connection count
+       */
+      size_t inUse( ) const { return metrics.leased.load( std::memory_order_relaxed ); }
+
+      /**
+       * @brief Get the pool statistics
+       *
+       * Reads only atomic counters, so may be scraped at any time without contending with
+       * checkouts; values are individually, not mutually, consistent
+       * @return statistics snapshot
+       */
+      PoolStats stats( ) const;
 
       /**
        * @brief Get a connection from the pool.
        *
-       * If the pool is empty create a new connection, otherwise wait for one
-       * to become available
+       * Waits, without limit, for a connection to become available
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
        * @return valid database connection
        * @throws DBException if no connection can be created
        */
-      Connection getConnection( ) noexcept( false ) {
-        if ( queue.empty( ) ) {
-          auto cxn = connect( );
+      Connection getConnection( PoolOptions::Priority priority = PoolOptions::NORMAL,
+                                const char *          site     = nullptr ) noexcept( false ) {
+        return getConnection( steady_clock_t::time_point::max( ), priority, site );
+      }
 
-          if ( !cxn->test( ) ) {
-            throw DBException( "Unable to connect to the database" );
-          }
-          return cxn;
+      /**
+       * @brief Get a connection from the pool.
+       *
+       * Waits up to timeout for a connection to become available; waiters are served by
+       * priority, aged by their wait, then in arrival order
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws DBException if no connection became available before the timeout
+       */
+      Connection getConnection( std::chrono::milliseconds timeout,
+                                PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                const char *              site     = nullptr ) noexcept( false ) {
+        return getConnection( steady_clock_t::now( ) + timeout, priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the pool.
+       *
+       * The most recently used idle connection is preferred; when none are idle a new
+       * connection is opened if the pool is below its maximum size, otherwise the caller
+       * waits for a connection to be returned. Checkouts are rejected immediately while
+       * the circuit breaker is open (after breakerLimit consecutive connection failures)
+       * or the waiter limit is reached. Only HIGH priority checkouts may use the reserved
+       * connections
+       * @param deadline time to give up waiting for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if the checkout was rejected without waiting
+       * @throws DBException if no connection became available before the deadline
+       */
+      Connection getConnection( steady_clock_t::time_point deadline,
+                                PoolOptions::Priority      priority = PoolOptions::NORMAL,
+                                const char *               site     = nullptr ) noexcept( false );
+
+      /**
+       * @brief Get a connection from the pool, preferring one with a statement already
+       *        prepared for a query
+       *
+       * Waits, without limit, for a connection to become available
+       * @param hint query string the caller will prepare
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws DBException if no connection can be created
+       */
+      Connection getConnection( const std::string &   hint,
+                                PoolOptions::Priority priority = PoolOptions::NORMAL,
+                                const char *          site     = nullptr ) noexcept( false ) {
+        return getConnection( hint, steady_clock_t::time_point::max( ), priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the pool, preferring one with a statement already
+       *        prepared for a query
+       * @param hint query string the caller will prepare
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws DBException if no connection became available before the timeout
+       */
+      Connection getConnection( const std::string &       hint,
+                                std::chrono::milliseconds timeout,
+                                PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                const char *              site     = nullptr ) noexcept( false ) {
+        return getConnection( hint, steady_clock_t::now( ) + timeout, priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the pool, preferring one with a statement already
+       *        prepared for a query
+       *
+       * Of the affinityScan most recently used idle connections, the first with the query
+       * in its statement cache is leased, saving the prepare round trip; failing that the
+       * checkout proceeds as an unhinted one. Hits and misses are counted in the pool
+       * statistics (affinityHits, affinityMisses)
+       * @param hint query string the caller will prepare, as passed to prepareStatement( )
+       * @param deadline time to give up waiting for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if the checkout was rejected without waiting
+       * @throws DBException if no connection became available before the deadline
+       */
+      Connection getConnection( const std::string &        hint,
+                                steady_clock_t::time_point deadline,
+                                PoolOptions::Priority      priority = PoolOptions::NORMAL,
+                                const char *               site     = nullptr ) noexcept( false );
+
+      /**
+       * @brief Get a connection from the pool only if one can be leased without waiting
+       *
+       * Fails, rather than waiting or throwing PoolUnavailable, while checkouts are parked,
+       * the pool is exhausted for the priority or the circuit breaker is open
+       * @param connection leased connection, set if leased
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return true if a connection was leased, false if not
+       * @throws DBException if a new connection can not be established
+       */
+      bool tryGetConnection( Connection &          connection,
+                             PoolOptions::Priority priority = PoolOptions::NORMAL,
+                             const char *          site     = nullptr ) noexcept( false );
+
+      /**
+       * @brief Stop new checkouts and wait for the outstanding leases to be returned
+       *
+       * Checkouts, including those already waiting, fail with PoolUnavailable until the
+       * pool is resumed
+       * @param deadline time to give up waiting for the leases
+       * @return true if every lease was returned, false if the deadline expired first
+       */
+      bool drain( steady_clock_t::time_point deadline ) noexcept( false );
+
+      /**
+       * @brief Stop new checkouts and wait for the outstanding leases to be returned
+       * @param timeout maximum time to wait for the leases
+       * @return true if every lease was returned, false if the timeout expired first
+       */
+      bool drain( std::chrono::milliseconds timeout ) noexcept( false ) {
+        return drain( steady_clock_t::now( ) + timeout );
+      }
+
+      /**
+       * @brief Accept checkouts again after a drain
+       */
+      void resume( ) { draining.store( false ); }
+
+      /**
+       * @brief Point the pool at a new uri, e.g. to rotate credentials or move to another host
+       *
+       * The monitor opens a replacement for every open connection in the background;
+       * each is swapped in when its connection is next checked out or returned, so
+       * checkouts never wait on the new connections. Reconnects and new connections use
+       * the new uri at once
+       * @param uri connection uri
+       */
+      void rebind( const std::string &uri );
+
+      /** Pending asynchronous checkout handle */
+      class Checkout {
+       public:
+        /**
+         * @brief Cancel the checkout, completing it with a DBException, unless a connection
+         *        has already been handed to it
+         * @return true if cancelled, false if already completed or being completed
+         */
+        bool cancel( ) {
+          auto pending = waiter.lock( );
+
+          return pending && pool->cancelAsync( pending.get( ) );
         }
 
-        do {
-          if ( auto ptr = getNextConnection( queue, queueLock ) ) {
-            if ( ptr->test( ) ) {
-              ptr->setAutoCommit( autoCommit );
-              return Connection( ptr, [this]( connection_t cxn ) { addConnection( cxn ); } );
+       private:
+        friend class Pool;
+
+        Checkout( Pool *_pool, std::weak_ptr< AsyncWaiter > _waiter )
+          : pool( _pool )
+          , waiter( std::move( _waiter ) ) {}
+
+        Pool *                       pool;
+        std::weak_ptr< AsyncWaiter > waiter;
+      };
+
+      /**
+       * @brief Get a connection from the pool without blocking the calling thread
+       *
+       * The handler is called exactly once: on the calling thread if a connection is
+       * free now, otherwise on the thread that frees one (the check-in of another lease),
+       * or on the pool monitor thread once the deadline expires. The handler must not
+       * block, and the pool must outlive the checkout
+       * @param handler completion handler
+       * @param deadline time to fail the checkout
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return handle to cancel the checkout
+       */
+      Checkout getConnectionAsync( checkout_handler_f         handler,
+                                   steady_clock_t::time_point deadline = steady_clock_t::time_point::max( ),
+                                   PoolOptions::Priority      priority = PoolOptions::NORMAL,
+                                   const char *               site     = nullptr ) {
+        auto waiter = std::make_shared< AsyncWaiter >( );
+
+        waiter->async    = true;
+        waiter->handler  = std::move( handler );
+        waiter->priority = priority;
+        waiter->site     = site;
+        waiter->start    = steady_clock_t::now( );
+        waiter->deadline = deadline;
+
+        Checkout checkout( this, waiter );
+
+        submitAsync( std::move( waiter ) );
+        return checkout;
+      }
+
+      /**
+       * @brief Get a connection from the pool without blocking the calling thread
+       * @param handler completion handler, see above
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return handle to cancel the checkout
+       */
+      Checkout getConnectionAsync( checkout_handler_f        handler,
+                                   std::chrono::milliseconds timeout,
+                                   PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                   const char *              site     = nullptr ) {
+        return getConnectionAsync( std::move( handler ), steady_clock_t::now( ) + timeout, priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the pool as a future, fulfilled as the completion
+       *        handler form is called
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return leased connection, or the checkout failure
+       */
+      std::future< Connection > getConnectionAsync( std::chrono::milliseconds timeout,
+                                                    PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                                    const char *              site     = nullptr ) {
+        auto promise = std::make_shared< std::promise< Connection > >( );
+        auto future  = promise->get_future( );
+
+        getConnectionAsync(
+          [ promise ]( std::exception_ptr error, Connection connection ) {
+            if ( error ) {
+              promise->set_exception( error );
             } else {
-              addReconnect( ptr );
+              promise->set_value( std::move( connection ) );
             }
-          }
-        } while ( true );
+          },
+          timeout,
+          priority,
+          site );
+
+        return future;
       }
 
      private:
-      std::vector< connection_t > connections;
-      std::queue< size_t >        queue;
-      std::mutex                  queueLock;
-      std::queue< size_t >        reconnect;
-      std::mutex                  reconnectLock;
-      std::unique_ptr< Uri >      uri;
-      std::thread                 asyncTest;
-      bool                        autoCommit;
-      bool                        asyncTestRunning;
+      PoolOptions                        options;
+      std::vector< Slot >                slots;
+      FreeList                           queue;
+      FreeList                           vacant;
+      std::atomic< size_t >              stale;
+      std::atomic< size_t >              open;
+      std::atomic< size_t >              unreserved;
+      std::deque< Waiter * >             waiters[ PoolOptions::PRIORITIES ];
+      std::atomic< size_t >              waiting;
+      std::atomic< bool >                draining;
+      std::condition_variable            drained;
+      async_list_t                       assigned;
+      std::atomic< steady_clock_t::rep > asyncExpiry;
+      std::mutex                         queueLock;
+      retry_queue_t                      reconnect;
+      std::mutex                         reconnectLock;
+      std::condition_variable            monitorWake;
+      std::minstd_rand                   random;
+      binding_t                          binding;
+      std::thread                        asyncTest;
+      std::atomic< bool >                asyncTestRunning;
+      Metrics                            metrics;
+      CircuitBreaker                     breaker;
     };
   } // namespace internal
 } // namespace dbcpp
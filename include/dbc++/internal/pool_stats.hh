@@ -0,0 +1,201 @@
+#ifndef __DBCPP_INTERNAL_POOL_STATS_HH__
+#define __DBCPP_INTERNAL_POOL_STATS_HH__
+
+#include "circuit_breaker.hh"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace dbcpp {
+  namespace internal {
+    /** Point in time copy of a Histogram */
+    struct HistogramSnapshot {
+      std::vector< uint64_t > counts; /**< Sample count per bucket */
+      uint64_t                count;  /**< Total sample count */
+      uint64_t                sum;    /**< Sum of all samples */
+      uint64_t                max;    /**< Largest sample */
+
+      /**
+       * @brief Get the mean sample value
+       * @return mean, 0 without samples
+       */
+      double mean( ) const { return count ? static_cast< double >( sum ) / count : 0.0; }
+
+      /**
+       * @brief Get the (bucket lower bound) value below which the fraction of samples fall
+       * @param fraction percentile as a fraction, e.g. 0.99
+       * @return percentile value, 0 without samples
+       */
+      uint64_t percentile( double fraction ) const;
+    };
+
+    /**
+     * Lock-free log-linear histogram
+     *
+     * Each power of two range is split into SUB_COUNT linear buckets, bounding the
+     * relative error of a recorded value to 1 / SUB_COUNT.
+     */
+    class Histogram {
+     public:
+      static const size_t SUB_BITS  = 3;
+      static const size_t SUB_COUNT = 1 << SUB_BITS;
+      static const size_t BUCKETS   = ( 64 - SUB_BITS + 1 ) * SUB_COUNT;
+
+      /**
+       * @brief Get the bucket a value is counted in
+       * @param value sample value
+       * @return bucket number
+       */
+      static size_t bucket( uint64_t value ) {
+        if ( value < SUB_COUNT ) {
+          return value;
+        }
+
+        size_t shift = 63 - __builtin_clzll( value ) - SUB_BITS;
+
+        return ( shift + 1 ) * SUB_COUNT + ( ( value >> shift ) & ( SUB_COUNT - 1 ) );
+      }
+
+      /**
+       * @brief Get the smallest value counted in a bucket
+       * @param bucket bucket number
+       * @return lower bound
+       */
+      static uint64_t lowerBound( size_t bucket ) {
+        if ( bucket < SUB_COUNT ) {
+          return bucket;
+        }
+
+        return static_cast< uint64_t >( SUB_COUNT + bucket % SUB_COUNT ) << ( bucket / SUB_COUNT - 1 );
+      }
+
+      Histogram( ) {
+        for ( auto &&count : counts ) {
+          count.store( 0, std::memory_order_relaxed );
+        }
+      }
+
+      /**
+       * @brief Record a sample
+       * @param value sample value
+       */
+      void record( uint64_t value ) {
+        counts[ bucket( value ) ].fetch_add( 1, std::memory_order_relaxed );
+        sum.fetch_add( value, std::memory_order_relaxed );
+
+        for ( auto current = max.load( std::memory_order_relaxed ); current < value; ) {
+          if ( max.compare_exchange_weak( current, value, std::memory_order_relaxed ) ) {
+            break;
+          }
+        }
+      }
+
+      /**
+       * @brief Record a duration sample in microseconds
+       * @param duration sample
+       */
+      template < typename Rep, typename Period >
+      void record( std::chrono::duration< Rep, Period > duration ) {
+        auto micros = std::chrono::duration_cast< std::chrono::microseconds >( duration ).count( );
+
+        record( static_cast< uint64_t >( micros > 0 ? micros : 0 ) );
+      }
+
+      /**
+       * @brief Copy the current counts
+       * @return histogram snapshot
+       */
+      HistogramSnapshot snapshot( ) const {
+        HistogramSnapshot snap{ std::vector< uint64_t >( BUCKETS ), 0, sum.load( std::memory_order_relaxed ),
+                                max.load( std::memory_order_relaxed ) };
+
+        for ( size_t bucket = 0; bucket < BUCKETS; ++bucket ) {
+          snap.counts[ bucket ] = counts[ bucket ].load( std::memory_order_relaxed );
+          snap.count += snap.counts[ bucket ];
+        }
+
+        return snap;
+      }
+
+     private:
+      std::atomic< uint64_t > counts[ BUCKETS ];
+      std::atomic< uint64_t > sum{ 0 };
+      std::atomic< uint64_t > max{ 0 };
+    };
+
+    inline uint64_t HistogramSnapshot::percentile( double fraction ) const {
+      auto     rank = static_cast< uint64_t >( fraction * count );
+      uint64_t seen = 0;
+
+      for ( size_t bucket = 0; bucket < counts.size( ); ++bucket ) {
+        if ( ( seen += counts[ bucket ] ) > rank ) {
+          return Histogram::lowerBound( bucket );
+        }
+      }
+
+      return max;
+    }
+
+    /** Lease held past the leak threshold */
+    struct LeaseInfo {
+      size_t                    index; /**< Pool slot */
+      std::chrono::microseconds age;   /**< Time since checkout */
+      const char *              site;  /**< Checkout call site tag, null if untagged */
+    };
+
+    /**
+     * Connection pool statistics snapshot
+     *
+     * Durations are recorded in microseconds. Counters are totals since the pool was
+     * created; gauges are the values at the time of the snapshot.
+     */
+    struct PoolStats {
+      /* Counters */
+      uint64_t checkouts;          /**< Successful checkouts */
+      uint64_t waits;              /**< Checkouts that had to park for a connection */
+      uint64_t timeouts;           /**< Checkouts that timed out */
+      uint64_t validationFailures; /**< Connections failing checkout or check-in validation */
+      uint64_t reconnects;         /**< Successful reconnects */
+      uint64_t reconnectFailures;  /**< Failed reconnect attempts */
+      uint64_t opened;             /**< Connections opened */
+      uint64_t closed;             /**< Connections closed */
+      uint64_t statementHits;      /**< Statements reused from a connection's statement cache */
+      uint64_t statementMisses;    /**< Statements prepared on a statement cache miss */
+      uint64_t affinityHits;       /**< Hinted checkouts served a connection with the statement cached */
+      uint64_t affinityMisses;     /**< Hinted checkouts served any other connection */
+      uint64_t rejections;         /**< Checkouts rejected by the breaker or waiter limit */
+      uint64_t retired;            /**< Connections replaced at their maximum lifetime */
+      uint64_t leaks;              /**< Leases reported held past the leak threshold */
+      uint64_t reclaimed;          /**< Leases reclaimed past the reclaim threshold */
+
+      /* Gauges */
+      size_t size;    /**< Open connections */
+      size_t inUse;   /**< Leased connections */
+      size_t idle;    /**< Idle connections */
+      size_t broken;  /**< Connections awaiting reconnection */
+      size_t waiting; /**< Parked checkouts */
+
+      CircuitBreaker::State    breaker; /**< Circuit breaker state */
+      std::vector< LeaseInfo > leases;  /**< Leases currently held past the leak threshold */
+
+      /* Histograms */
+      HistogramSnapshot waitTime;      /**< Time from checkout request to lease */
+      HistogramSnapshot leaseTime;     /**< Time from lease to check-in */
+      HistogramSnapshot reconnectTime; /**< Time taken by reconnect attempts */
+
+      /* Per checkout priority class, indexed by PoolOptions::Priority */
+      std::vector< HistogramSnapshot > classWaitTime; /**< Time from checkout request to lease */
+      std::vector< uint64_t >          classTimeouts; /**< Checkouts that timed out */
+    };
+
+    /** Sharded pool statistics, per shard */
+    struct ShardStats {
+      PoolStats pool;   /**< Shard pool statistics */
+      uint64_t  stolen; /**< Checkouts by the shard's threads served by another shard */
+      uint64_t  lent;   /**< Checkouts by other shards' threads served by this shard */
+    };
+  } // namespace internal
+} // namespace dbcpp
+
+#endif
@@ -123,10 +123,63 @@ namespace dbcpp {
       size_t row( ) const { return results->row( ); }
 
       /**
-       * @brief Advance to the next result row
+       * @brief Advance to the next result row, setting the bound variables
        * @return true on success, false for no more rows
        */
-      bool next( ) { return results->next( ); }
+      bool next( ) {
+        if ( !results->next( ) ) {
+          return false;
+        }
+
+        for ( auto &&column : bound ) {
+          if ( column.field ) {
+            auto null = column.field->isNull( );
+
+            if ( column.isNull ) {
+              *column.isNull = null;
+            }
+
+            if ( !null ) {
+              column.field->get( column.type, column.target );
+            }
+          }
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Bind a column to a variable, set from each row next( ) advances to
+       * @param field column number (zero start)
+       * @param target variable, which must outlive the binding; left unchanged for a null
+       * @param isNull null indicator, set from each row; nullptr if not wanted
+       * @return true on success, false on failure
+       */
+      template < typename T >
+      bool bindColumn( size_t field, T *target, bool *isNull = nullptr ) {
+        auto type = HostTypeDecoder::type< T >::value;
+
+        if ( results->bindColumn( field, type, target, isNull ) ) {
+          return true;
+        }
+
+        if ( field >= fields( ) ) {
+          return false;
+        }
+
+        /* The driver does not bind columns: read the bound fields after each next( ) */
+        bound.resize( fields( ) );
+        bound[ field ] = Bound{ results->get( field ), type, target, isNull };
+        return true;
+      }
+
+      /**
+       * @brief Remove the column bindings
+       */
+      void unbindColumns( ) {
+        results->unbindColumns( );
+        bound.clear( );
+      }
 
       /**
        * @brief Get a column value by column number
@@ -224,7 +277,16 @@ namespace dbcpp {
       bool operator==( const ResultSet &rhs ) const { return results == rhs.results; }
 
      private:
+      /** Column bound to a variable, without driver support */
+      struct Bound {
+        std::shared_ptr< interface::Field > field; /**< nullptr if not bound */
+        HostType                            type;
+        void *                              target;
+        bool *                              isNull;
+      };
+
       std::shared_ptr< result_set_t > results; /**< Driver Implementation pointer */
+      std::vector< Bound >            bound;   /**< Bound columns, by column number */
     };
   } // namespace internal
 } // namespace dbcpp
@@ -0,0 +1,139 @@
+#ifndef __DBCPP_INTERNAL_SHARDED_POOL_HH__
+#define __DBCPP_INTERNAL_SHARDED_POOL_HH__
+
+#include "pool.hh"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dbcpp {
+  namespace internal {
+    /** Sharded connection pool settings */
+    struct ShardOptions {
+      /** Unit a shard serves */
+      enum Sharding {
+        PER_CPU  = 0, /**< One shard per CPU */
+        PER_NODE = 1, /**< One shard per NUMA node */
+      };
+
+      /* minIdle is split across the shards, remainder first: below the shard count, the later shards keep none idle */
+      PoolOptions pool;               /**< Pool settings; minIdle and maxSize are split across the shards */
+      Sharding    sharding = PER_CPU; /**< Shard assignment */
+      size_t      shards   = 0;       /**< Shard count, 0 for one per CPU or node (at most maxSize) */
+    };
+
+    /**
+     * Connection pool split into independent shards, one per CPU or NUMA node
+     *
+     * Each shard is a Pool of its own, so checkouts on different CPUs do not share free
+     * lists, waiter locks or counters. That includes the pool monitor: every shard runs
+     * its own monitor thread and idle checks, so a pool of one shard per CPU costs a
+     * thread per CPU; set shards to bound it. A checkout is served by the calling thread's shard
+     * when it has a connection free, otherwise by the first other shard that has (a
+     * steal), and only then waits on its own shard.
+     */
+    class ShardedPool {
+      using steady_clock_t = std::chrono::steady_clock;
+
+     public:
+      /**
+       * @brief Create the shard pools
+       * @param uri connection uri
+       * @param options sharded pool settings
+       * @throws DBException if no connection can be established
+       */
+      ShardedPool( const std::string &uri, const ShardOptions &options );
+
+      /**
+       * @brief Get the number of shards
+       * @return shard count
+       */
+      size_t size( ) const { return shards.size( ); }
+
+      /**
+       * @brief Get a shard's pool
+       * @param index shard index
+       * @return shard pool
+       */
+      Pool &shard( size_t index ) { return *shards[ index ]->pool; }
+
+      /**
+       * @brief Get the shard serving the calling thread, by the CPU it is running on
+       * @return shard index
+       */
+      size_t localShard( ) const;
+
+      /**
+       * @brief Get a shard's statistics
+       * @param index shard index
+       * @return statistics snapshot
+       */
+      ShardStats stats( size_t index ) const {
+        auto &shard = *shards[ index ];
+
+        return ShardStats{ shard.pool->stats( ),
+                           shard.stolen.load( std::memory_order_relaxed ),
+                           shard.lent.load( std::memory_order_relaxed ) };
+      }
+
+      /**
+       * @brief Get a connection, waiting without limit
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws DBException if no connection can be created
+       */
+      Connection getConnection( PoolOptions::Priority priority = PoolOptions::NORMAL,
+                                const char *          site     = nullptr ) noexcept( false ) {
+        return getConnection( steady_clock_t::time_point::max( ), priority, site );
+      }
+
+      /**
+       * @brief Get a connection, waiting up to timeout
+       * @param timeout maximum time to wait for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws DBException if no connection became available before the timeout
+       */
+      Connection getConnection( std::chrono::milliseconds timeout,
+                                PoolOptions::Priority     priority = PoolOptions::NORMAL,
+                                const char *              site     = nullptr ) noexcept( false ) {
+        return getConnection( steady_clock_t::now( ) + timeout, priority, site );
+      }
+
+      /**
+       * @brief Get a connection from the local shard, stealing from another shard when the
+       *        local one has none free, and otherwise waiting on the local shard
+       * @param deadline time to give up waiting for a connection
+       * @param priority checkout priority
+       * @param site call site tag (e.g. DBCPP_CALL_SITE) reported for leaked leases
+       * @return valid database connection
+       * @throws PoolUnavailable if the local shard rejected the checkout without waiting
+       * @throws DBException if no connection became available before the deadline
+       */
+      Connection getConnection( steady_clock_t::time_point deadline,
+                                PoolOptions::Priority      priority = PoolOptions::NORMAL,
+                                const char *               site     = nullptr ) noexcept( false );
+
+     private:
+      /**
+       * Shard pool and its steal counters, padded on both sides: plain new does not honour
+       * an alignas beyond the fundamental alignment, so the shard can not be cache line
+       * aligned, yet its counters must not share a line with a neighbouring allocation
+       */
+      struct Shard {
+        char                    leading[ 64 ];
+        std::unique_ptr< Pool > pool;
+        std::atomic< uint64_t > stolen{ 0 };
+        std::atomic< uint64_t > lent{ 0 };
+        char                    trailing[ 64 ];
+      };
+
+      std::vector< std::unique_ptr< Shard > > shards;
+      std::vector< size_t >                   cpuShard; /**< Shard serving each CPU */
+    };
+  } // namespace internal
+} // namespace dbcpp
+
+#endif
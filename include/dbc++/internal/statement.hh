@@ -3,6 +3,7 @@
 
 #include "../dbi/statement.hh"
 #include "resultset.hh"
+#include <functional>
 
 namespace dbcpp {
   namespace internal {
@@ -25,6 +26,8 @@ namespace dbcpp {
       }
 
       int executeUpdate( ) {
+        setHosts( );
+
         int updated = statement->executeUpdate( );
         reset       = true;
         nextParam   = 0;
@@ -32,11 +35,67 @@ namespace dbcpp {
       }
 
       void execute( ) {
+        setHosts( );
         statement->execute( );
         reset     = true;
         nextParam = 0;
       }
 
+      /**
+       * @brief Add the bound parameters to the batch, and start binding the next set
+       */
+      void addBatch( ) {
+        setHosts( );
+        statement->addBatch( );
+        reset     = true;
+        nextParam = 0;
+      }
+
+      /**
+       * @brief Execute the batched parameter sets, in one round trip where the driver allows
+       * @return number of affected rows, per parameter set
+       */
+      std::vector< int > executeBatch( ) {
+        auto counts = statement->executeBatch( );
+        reset       = true;
+        nextParam   = 0;
+        return counts;
+      }
+
+      /**
+       * @brief Bind a parameter to a host variable, read by every execution until unbindParams( )
+       * @param parameter parameter index (0 start)
+       * @param address host variable, which must outlive the binding
+       * @param isNull null indicator, nullptr if never null
+       * @return true on success, false on failure
+       */
+      template < typename T >
+      bool bindParam( size_t parameter, const T *address, const bool *isNull = nullptr ) {
+        if ( statement->bindParam( parameter, HostTypeDecoder::type< T >::value, address, isNull ) ) {
+          return true;
+        }
+
+        /* The driver does not bind host variables: set their values before each execution */
+        if ( hosts.size( ) <= parameter ) {
+          hosts.resize( parameter + 1 );
+        }
+
+        hosts[ parameter ] = [ parameter, address, isNull ]( Statement &self ) {
+          return ( isNull && *isNull ) ? self.setParamNull( parameter, FieldTypeDecoder::type< T >::value )
+                                       : self.setParam( parameter, *address );
+        };
+
+        return true;
+      }
+
+      /**
+       * @brief Remove the host variable bindings
+       */
+      void unbindParams( ) {
+        statement->unbindParams( );
+        hosts.clear( );
+      }
+
       /**
        * @brief Set the parameter as null
        * @param parameter parameter index (0 start)
@@ -95,7 +154,7 @@ namespace dbcpp {
           reset = false;
         }
 
-        return statement->setParam( parameter, value );
+        return statement->setParam( parameter, std::move( value ) );
       }
 
       Statement &operator<<( decltype( nullptr ) ) {
@@ -105,14 +164,26 @@ namespace dbcpp {
 
       template < typename T >
       Statement &operator<<( T value ) {
-        setParam( nextParam++, value );
+        setParam( nextParam++, std::move( value ) );
         return *this;
       }
 
      private:
-      size_t                         nextParam;
-      std::shared_ptr< statement_t > statement;
-      bool                           reset;
+      /**
+       * @brief Set the host variables bound without driver support
+       */
+      void setHosts( ) {
+        for ( auto &&host : hosts ) {
+          if ( host ) {
+            host( *this );
+          }
+        }
+      }
+
+      size_t                                             nextParam;
+      std::shared_ptr< statement_t >                     statement;
+      bool                                               reset;
+      std::vector< std::function< bool( Statement & ) > > hosts; /**< Host variable setters, by parameter */
     };
   } // namespace internal
 } // namespace dbcpp
@@ -0,0 +1,142 @@
+#ifndef __DBCPP_INTERNAL_TYPED_QUERY_HH__
+#define __DBCPP_INTERNAL_TYPED_QUERY_HH__
+
+#include "statement.hh"
+#include "utils.hh"
+#include <memory>
+#include <string>
+#include <tuple>
+
+namespace dbcpp {
+  namespace internal {
+    /**
+     * Query with its parameter types fixed at build time
+     *
+     * The placeholders are counted when the query is constructed: declared constexpr, a
+     * query whose placeholder count does not match its parameter types fails to compile,
+     * otherwise it throws DBException. Only a pointer to the query is kept, so it must be
+     * a string literal (or another array outliving the typed query); modifiable arrays are
+     * refused.
+     */
+    template < typename... Args >
+    class TypedQuery {
+     public:
+      /**
+       * @brief Create the query from a string literal, without its surrounding white space
+       * @param query query string, with a ? placeholder per parameter type
+       * @throws DBException if the placeholder count does not match the parameter types
+       */
+      template < size_t N >
+      constexpr TypedQuery( const char ( &query )[ N ] )
+        : text( query + utils::leading( query, N - 1 ) )
+        , length( utils::placeholders( query, 0, N - 1 ) == sizeof...( Args )
+                    ? utils::trimmed( query + utils::leading( query, N - 1 ), N - 1 - utils::leading( query, N - 1 ) )
+                    : throw DBException( "Query placeholder count does not match its parameter types" ) ) {}
+
+      template < size_t N >
+      TypedQuery( char ( &query )[ N ] ) = delete;
+
+      /**
+       * @brief Get the query string
+       * @return query string
+       */
+      std::string query( ) const { return std::string( text, length ); }
+
+     private:
+      const char *text;
+      size_t      length;
+    };
+
+    /**
+     * Prepared statement of a TypedQuery
+     *
+     * The parameters are bound to host variables kept by the typed statement, so each
+     * execution only copies the arguments and has the driver encode them, by the types
+     * fixed when bound. The underlying statement stays bound until the typed statement is
+     * destroyed.
+     */
+    template < typename... Args >
+    class TypedStatement {
+     public:
+      explicit TypedStatement( Statement _statement )
+        : statement( std::move( _statement ) )
+        , values( new std::tuple< Args... >( ) ) {
+        bind( );
+      }
+
+      TypedStatement( TypedStatement && ) = default;
+      TypedStatement( const TypedStatement & ) = delete;
+      TypedStatement &operator=( const TypedStatement & ) = delete;
+
+      ~TypedStatement( ) {
+        if ( values ) {
+          statement.unbindParams( );
+        }
+      }
+
+      /**
+       * @brief Execute the query
+       * @param args parameter values
+       * @note Throws DBException
+       */
+      void execute( const Args &... args ) {
+        *values = std::forward_as_tuple( args... );
+        statement.execute( );
+      }
+
+      /**
+       * @brief Execute the query
+       * @param args parameter values
+       * @return result set
+       * @note Throws DBException
+       */
+      ResultSet executeQuery( const Args &... args ) {
+        *values = std::forward_as_tuple( args... );
+        return statement.executeQuery( );
+      }
+
+      /**
+       * @brief Execute a modification query (delete,insert,update)
+       * @param args parameter values
+       * @return number of affected rows
+       * @note Throws DBException
+       */
+      int executeUpdate( const Args &... args ) {
+        *values = std::forward_as_tuple( args... );
+        return statement.executeUpdate( );
+      }
+
+      /**
+       * @brief Add a parameter set to the batch
+       * @param args parameter values
+       * @note Throws DBException
+       */
+      void addBatch( const Args &... args ) {
+        *values = std::forward_as_tuple( args... );
+        statement.addBatch( );
+      }
+
+      /**
+       * @brief Execute the batched parameter sets
+       * @return number of affected rows, per parameter set
+       * @note Throws DBException
+       */
+      std::vector< int > executeBatch( ) { return statement.executeBatch( ); }
+
+     private:
+      template < size_t I = 0 >
+      typename std::enable_if< ( I < sizeof...( Args ) ) >::type bind( ) {
+        statement.bindParam( I, &std::get< I >( *values ) );
+        bind< I + 1 >( );
+      }
+
+      template < size_t I = 0 >
+      typename std::enable_if< ( I == sizeof...( Args ) ) >::type bind( ) {}
+
+      Statement                               statement;
+      std::unique_ptr< std::tuple< Args... > > values; /**< Host variables, by parameter */
+    };
+  } // namespace internal
+} // namespace dbcpp
+
+#endif
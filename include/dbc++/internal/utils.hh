@@ -1,12 +1,76 @@
 #ifndef __UTILS_HH_
 #define __UTILS_HH_
 
+#include <cstddef>
 #include <string>
 
 namespace dbcpp {
   namespace internal {
     namespace utils {
       bool stob( const std::string );
+
+      /**
+       * @brief Identify a white space character, at compile time
+       * @param value character
+       * @return true if white space, false if not
+       */
+      constexpr bool space( char value ) {
+        return ( value == ' ' ) || ( value == '\t' ) || ( value == '\n' ) || ( value == '\r' ) || ( value == '\v' ) ||
+               ( value == '\f' );
+      }
+
+      /**
+       * @brief Count the leading white space of a string, at compile time
+       * @param text string
+       * @param length string length
+       * @return leading white space length, at most the string length
+       */
+      constexpr size_t leading( const char *text, size_t length ) {
+        return ( length && space( *text ) ) ? 1 + leading( text + 1, length - 1 ) : 0;
+      }
+
+      /**
+       * @brief Get the length of a string without its trailing white space, at compile time
+       * @param text string
+       * @param length string length
+       * @return trimmed length
+       */
+      constexpr size_t trimmed( const char *text, size_t length ) {
+        return ( length && space( text[ length - 1 ] ) ) ? trimmed( text, length - 1 ) : length;
+      }
+
+      /**
+       * @brief Count the single quotes in a range of a query, at compile time
+       * @param query query string
+       * @param begin range start
+       * @param end range end
+       * @return quote count
+       */
+      constexpr size_t quotes( const char *query, size_t begin, size_t end ) {
+        return ( end - begin > 1 )
+                 ? quotes( query, begin, ( begin + end ) / 2 ) + quotes( query, ( begin + end ) / 2, end )
+                 : ( ( end > begin ) && ( query[ begin ] == '\'' ) ? 1 : 0 );
+      }
+
+      /**
+       * @brief Count the ? placeholders in a range of a query, outside of quoted literals, at
+       *        compile time; the range is halved, so long queries stay within the compiler's
+       *        constexpr recursion depth
+       * @param query query string
+       * @param begin range start
+       * @param end range end
+       * @param quoted true if the range starts inside a quoted literal
+       * @return placeholder count
+       */
+      constexpr size_t placeholders( const char *query, size_t begin, size_t end, bool quoted = false ) {
+        return ( end - begin > 1 )
+                 ? placeholders( query, begin, ( begin + end ) / 2, quoted ) +
+                     placeholders( query,
+                                   ( begin + end ) / 2,
+                                   end,
+                                   quoted != ( quotes( query, begin, ( begin + end ) / 2 ) % 2 == 1 ) )
+                 : ( ( end > begin ) && !quoted && ( query[ begin ] == '?' ) ? 1 : 0 );
+      }
     }
   } // namespace internal
 } // namespace dbcpp
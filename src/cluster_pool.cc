@@ -0,0 +1,233 @@
+#include "dbc++/dbcpp.hh"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace dbcpp {
+#define LOG( logger, lvl, ... )                                                                                        \
+  do {                                                                                                                 \
+    if ( logger->should_log( spdlog::level::lvl ) ) {                                                                  \
+      SPDLOG_LOGGER_CALL( logger, spdlog::level::lvl, __VA_ARGS__ );                                                   \
+    }                                                                                                                  \
+  } while ( 0 )
+
+  namespace {
+    /** Cluster logger */
+    std::shared_ptr< spdlog::logger > logger = create_logger( "dbcpp::ClusterPool", { } );
+  } // namespace
+
+  ClusterPool::ClusterPool( const std::vector< Endpoint > &endpoints, const ClusterOptions &_options )
+    : options( _options )
+    , primary( nullptr )
+    , rotation( 0 )
+    , running( true ) {
+    for ( auto &&endpoint : endpoints ) {
+      std::unique_ptr< Member > member( new Member );
+
+      member->endpoint = endpoint;
+
+      if ( endpoint.role == PRIMARY ) {
+        if ( primary ) {
+          throw DBException( "Cluster has more than one primary endpoint" );
+        }
+
+        primary = member.get( );
+      }
+
+      /* Only writes carry a commit position worth capturing */
+      auto settings = options.pool;
+
+      settings.trackCommits = settings.trackCommits || ( endpoint.role == PRIMARY );
+
+      try {
+        member->pool.reset( new Pool( endpoint.uri, settings ) );
+      } catch ( DBException &ex ) {
+        /* Unreachable for now; the pool fills once the endpoint is back */
+        auto cold = settings;
+
+        LOG( logger, warn, "Unable to open connections to cluster endpoint {}: {}", endpoint.uri, ex.what( ) );
+
+        cold.minIdle = 0;
+        member->pool.reset( new Pool( endpoint.uri, cold ) );
+      }
+
+      members.push_back( std::move( member ) );
+    }
+
+    if ( !primary ) {
+      throw DBException( "Cluster has no primary endpoint" );
+    }
+
+    checkHealth( );
+
+    healthMonitor = std::thread( &ClusterPool::monitor, this );
+  }
+
+  ClusterPool::~ClusterPool( ) {
+    {
+      std::lock_guard< std::mutex > guard( healthLock );
+      running = false;
+    }
+
+    healthWake.notify_one( );
+    healthMonitor.join( );
+  }
+
+  void ClusterPool::monitor( ) {
+    std::unique_lock< std::mutex > guard( healthLock );
+
+    while ( !healthWake.wait_for( guard, options.healthInterval, [ this ]( ) { return !running; } ) ) {
+      guard.unlock( );
+      checkHealth( );
+      guard.lock( );
+    }
+  }
+
+  void ClusterPool::checkHealth( ) {
+    auto deadline = steady_clock_t::now( ) + options.healthTimeout;
+
+    for ( auto &&member : members ) {
+      if ( member->check.valid( ) ) {
+        continue; // Still stuck in an earlier check
+      }
+
+      auto endpoint = member.get( );
+
+      member->check = std::async( std::launch::async, [ endpoint ]( ) {
+        try {
+          if ( !endpoint->probe ) {
+            endpoint->probe.reset( new Connection( Driver::connect( endpoint->endpoint.uri ) ) );
+          }
+
+          auto start = steady_clock_t::now( );
+
+          if ( endpoint->probe->test( ) ) {
+            endpoint->elapsed = steady_clock_t::now( ) - start;
+            endpoint->position.store( endpoint->probe->replayPosition( ) );
+            return true;
+          }
+        } catch ( std::exception & ) {
+        }
+
+        /* Reconnected on the next check */
+        endpoint->probe.reset( );
+        return false;
+      } );
+    }
+
+    for ( auto &&member : members ) {
+      bool passed = false;
+
+      if ( member->check.wait_until( deadline ) == std::future_status::ready ) {
+        passed = member->check.get( );
+      }
+
+      if ( passed ) {
+        auto sample  = std::chrono::duration< double, std::micro >( member->elapsed ).count( );
+        auto average = member->latency.load( );
+
+        member->latency.store( average ? average + options.latencyWeight * ( sample - average ) : sample );
+      }
+
+      if ( member->healthy.exchange( passed ) != passed ) {
+        if ( passed ) {
+          LOG( logger, info, "Cluster endpoint {} is up", member->endpoint.uri );
+        } else {
+          LOG( logger, warn, "Cluster endpoint {} failed its health check, draining", member->endpoint.uri );
+        }
+      }
+    }
+  }
+
+  std::vector< ClusterPool::Member * > ClusterPool::route( Access access, uint64_t position ) {
+    std::vector< Member * > candidates;
+
+    if ( access == READ_ONLY ) {
+      for ( auto &&member : members ) {
+        if ( ( member->endpoint.role == REPLICA ) && member->healthy.load( ) &&
+             ( member->position.load( ) >= position ) ) {
+          candidates.push_back( member.get( ) );
+        }
+      }
+
+      /* Rotate first, so equally ranked replicas share the load */
+      if ( !candidates.empty( ) ) {
+        std::rotate( candidates.begin( ),
+                     candidates.begin( ) + rotation.fetch_add( 1, std::memory_order_relaxed ) % candidates.size( ),
+                     candidates.end( ) );
+      }
+
+      if ( options.routing == ClusterOptions::LOWEST_LATENCY ) {
+        std::stable_sort( candidates.begin( ), candidates.end( ), []( Member *lhs, Member *rhs ) {
+          return lhs->latency.load( ) < rhs->latency.load( );
+        } );
+      } else {
+        std::stable_sort( candidates.begin( ), candidates.end( ), []( Member *lhs, Member *rhs ) {
+          return lhs->pool->inUse( ) < rhs->pool->inUse( );
+        } );
+      }
+    }
+
+    if ( primary->healthy.load( ) ) {
+      candidates.push_back( primary );
+    }
+
+    return candidates;
+  }
+
+  Connection ClusterPool::getConnection( Access                     access,
+                                         uint64_t                   position,
+                                         steady_clock_t::time_point deadline,
+                                         PoolOptions::Priority      priority,
+                                         const char *               site ) {
+    auto               candidates = route( access, position );
+    std::exception_ptr failure;
+
+    if ( candidates.empty( ) ) {
+      throw PoolUnavailable( access == READ_WRITE ? "Cluster primary is down" : "No cluster endpoint is up" );
+    }
+
+    /* Any idle connection, on any candidate, before waiting on one */
+    for ( auto &&member : candidates ) {
+      Connection connection( nullptr );
+
+      try {
+        if ( member->pool->tryGetConnection( connection, priority, site ) ) {
+          return connection;
+        }
+      } catch ( DBException &ex ) {
+        LOG( logger, debug, "Checkout from cluster endpoint {} failed: {}", member->endpoint.uri, ex.what( ) );
+        failure = std::current_exception( );
+      }
+    }
+
+    auto slice  = std::chrono::duration_cast< steady_clock_t::duration >(
+      std::max( options.healthInterval, std::chrono::milliseconds( 1 ) ) );
+    bool waited = false;
+
+    /* Wait on the candidates in turn, a health interval at a time, so a stalled one still fails over */
+    for ( size_t num = 0;; ++num ) {
+      if ( num % candidates.size( ) == 0 ) {
+        /* Give up past the deadline, or once every candidate failed outright rather than waiting */
+        if ( num && ( !waited || ( steady_clock_t::now( ) >= deadline ) ) ) {
+          break;
+        }
+
+        waited = false;
+      }
+
+      auto member = candidates[ num % candidates.size( ) ];
+      auto now    = steady_clock_t::now( );
+      auto until  = deadline - now > slice ? now + slice : deadline;
+
+      try {
+        return member->pool->getConnection( until, priority, site );
+      } catch ( DBException &ex ) {
+        LOG( logger, debug, "Checkout from cluster endpoint {} failed: {}", member->endpoint.uri, ex.what( ) );
+        failure = std::current_exception( );
+        waited  = waited || ( steady_clock_t::now( ) >= until );
+      }
+    }
+
+    std::rethrow_exception( failure );
+  }
+} // namespace dbcpp
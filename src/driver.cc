@@ -144,18 +144,30 @@ namespace dbcpp {
    ***********/
 
   /**
-   * @brief Establish a pool connection
-   * @return established connection
+   * @brief Create an unconnected pool connection
+   * @return created connection
    */
-  internal::Pool::connection_t internal::Pool::connect( ) {
-    auto driver = Driver::getDriver( uri.get( ) );
-    auto cxn    = driver->createConnection( uri.get( ) );
+  internal::Pool::connection_t internal::Pool::create( const Binding &target ) {
+    auto driver = Driver::getDriver( target.uri.get( ) );
+    auto cxn    = driver->createConnection( target.uri.get( ) );
 
     if ( cxn == nullptr ) {
       throw std::runtime_error( "Connection create failed" );
     }
 
-    cxn->setAutoCommit( autoCommit );
+    cxn->setAutoCommit( options.autoCommit );
+    cxn->trackCommitPosition( options.trackCommits );
+    cxn->statementCache( ).resize( options.statementCache );
+
+    return cxn;
+  }
+
+  /**
+   * @brief Establish a pool connection
+   * @return established connection
+   */
+  internal::Pool::connection_t internal::Pool::connect( const Binding &target ) {
+    auto cxn = create( target );
 
     if ( !cxn->connect( ) ) {
       throw std::runtime_error( "Unable to connect" );
@@ -1,6 +1,8 @@
 
 #include "dbc++/dbcpp.hh"
 #include <algorithm>
+#include <cerrno>
+#include <poll.h>
 #include <spdlog/spdlog.h>
 
 #include <spdlog/sinks/null_sink.h>
@@ -16,20 +18,211 @@ namespace dbcpp {
     }                                                                                                                  \
   } while ( 0 )
 
-  Pool::Pool( const std::string &_uri, size_t count, bool _autoCommit, std::chrono::duration< double > checkPeriod )
-    : uri( Uri::parse( _uri ) )
-    , autoCommit( _autoCommit ) {
-    auto endpoint = fmt::format( "{}://{}:{}/{}", uri->scheme( ), uri->host( ), uri->port( ), uri->resource( ) );
+  namespace {
+    using steady_clock_t = std::chrono::steady_clock;
 
-    LOG( logger, info, "Creating connection pool of {} for {}", count, endpoint );
+    /** Outcome of a concurrent connection attempt */
+    struct ConnectResult {
+      bool                     connected; /**< Connection established */
+      steady_clock_t::duration elapsed;   /**< Time until established or abandoned */
+    };
 
-    count = std::max( count, ( size_t ) 1 );
-    for ( size_t num = 0; num < count; ++num ) {
-      connections.push_back( connect( ) );
-      queue.push( connections.size( ) - 1 );
+    /**
+     * @brief Prepare the hot statements on a newly established connection, before it is
+     *        handed out, so its first requests skip the prepare round trips
+     * @param connection established connection
+     * @param statements statements to prepare
+     */
+    void prepareHot( interface::Connection &connection, const std::vector< std::string > &statements ) {
+      if ( statements.empty( ) ) {
+        return;
+      }
+
+      try {
+        for ( auto &&failure : connection.prepareStatements( statements ) ) {
+          LOG( logger, warn, "Unable to prepare hot statement '{}': {}", failure.first, failure.second );
+        }
+      } catch ( std::exception &ex ) {
+        LOG( logger, warn, "Unable to prepare the hot statements: {}", ex.what( ) );
+      }
+    }
+
+    /**
+     * @brief Drive several connections' non-blocking state machines, establishing or
+     *        testing them, from a single poll loop
+     * @param connections connections to drive
+     * @param deadline time to abandon the connections still in progress
+     * @param begin start the state machine of a connection
+     * @param advance advance the state machine of a connection whose socket is ready
+     * @return outcome, per connection
+     */
+    template < class Begin, class Advance >
+    std::vector< ConnectResult > pollAll( const std::vector< std::shared_ptr< interface::Connection > > &connections,
+                                          steady_clock_t::time_point deadline,
+                                          Begin                      begin,
+                                          Advance                    advance ) {
+      using State = interface::Connection::ConnectState;
+
+      auto                         start = steady_clock_t::now( );
+      std::vector< State >         states;
+      std::vector< ConnectResult > results( connections.size( ), ConnectResult{ false, { } } );
+      std::vector< pollfd >        fds;
+      std::vector< size_t >        polled;
+
+      auto finish = [ & ]( size_t num ) {
+        results[ num ].connected = states[ num ] == State::CONNECT_OK;
+        results[ num ].elapsed   = steady_clock_t::now( ) - start;
+      };
+
+      for ( size_t num = 0; num < connections.size( ); ++num ) {
+        states.push_back( begin( *connections[ num ] ) );
+        finish( num );
+      }
+
+      do {
+        fds.clear( );
+        polled.clear( );
+
+        for ( size_t num = 0; num < states.size( ); ++num ) {
+          if ( ( states[ num ] == State::CONNECT_READING ) || ( states[ num ] == State::CONNECT_WRITING ) ) {
+            short events = states[ num ] == State::CONNECT_READING ? POLLIN : POLLOUT;
+
+            fds.push_back( pollfd{ connections[ num ]->socket( ), events, 0 } );
+            polled.push_back( num );
+          }
+        }
+
+        if ( fds.empty( ) ) {
+          break;
+        }
+
+        auto remaining = std::chrono::duration_cast< std::chrono::milliseconds >( deadline - steady_clock_t::now( ) );
+        int  ready     = -1;
+
+        if ( remaining.count( ) > 0 ) {
+          ready = ::poll( &fds[ 0 ], fds.size( ), remaining.count( ) );
+
+          if ( ( ready < 0 ) && ( errno == EINTR ) ) {
+            continue; // Interrupted by a signal; poll again with the remaining time
+          }
+        }
+
+        if ( ready < 0 ) {
+          for ( auto &&num : polled ) {
+            connections[ num ]->disconnect( );
+            states[ num ] = State::CONNECT_FAILED;
+            finish( num );
+          }
+          break;
+        }
+
+        for ( size_t fd = 0; fd < fds.size( ); ++fd ) {
+          if ( fds[ fd ].revents || ( fds[ fd ].fd < 0 ) ) {
+            states[ polled[ fd ] ] = advance( *connections[ polled[ fd ] ] );
+            finish( polled[ fd ] );
+          }
+        }
+      } while ( true );
+
+      return results;
     }
 
-    LOG( logger, info, "Connection pool of {} for {} completed", count, endpoint );
+    /**
+     * @brief Establish several connections concurrently
+     * @param connections unconnected connections
+     * @param deadline time to abandon the connections still in progress
+     * @param statements statements to prepare on each established connection
+     * @return connection outcome, per connection
+     */
+    std::vector< ConnectResult >
+      connectAll( const std::vector< std::shared_ptr< interface::Connection > > &connections,
+                  steady_clock_t::time_point                                     deadline,
+                  const std::vector< std::string > &                             statements ) {
+      auto results = pollAll(
+        connections,
+        deadline,
+        []( interface::Connection &connection ) { return connection.connectStart( ); },
+        []( interface::Connection &connection ) { return connection.connectPoll( ); } );
+
+      for ( size_t num = 0; num < connections.size( ); ++num ) {
+        if ( results[ num ].connected ) {
+          prepareHot( *connections[ num ], statements );
+        }
+      }
+
+      return results;
+    }
+
+    /**
+     * @brief Test several connections concurrently
+     * @param connections established connections
+     * @param deadline time to fail the tests still in progress
+     * @return test outcome, per connection
+     */
+    std::vector< ConnectResult > testAll( const std::vector< std::shared_ptr< interface::Connection > > &connections,
+                                          steady_clock_t::time_point deadline ) {
+      return pollAll(
+        connections,
+        deadline,
+        []( interface::Connection &connection ) { return connection.testStart( ); },
+        []( interface::Connection &connection ) { return connection.testPoll( ); } );
+    }
+  } // namespace
+
+  Pool::Pool( const std::string &_uri, const PoolOptions &_options )
+    : options( _options )
+    , slots( std::max( _options.maxSize, ( size_t ) 1 ) )
+    , queue( slots.size( ) )
+    , vacant( slots.size( ) )
+    , stale( 0 )
+    , open( 0 )
+    , unreserved( 0 )
+    , waiting( 0 )
+    , draining( false )
+    , asyncExpiry( 0 )
+    , random( std::random_device{ }( ) )
+    , binding( bind( _uri, 1 ) )
+    , asyncTestRunning( true )
+    , breaker( options.breakerLimit, options.breakerDelay ) {
+    auto endpoint    = binding->endpoint;
+    auto checkPeriod = options.checkPeriod;
+
+    options.maxSize = slots.size( );
+    options.minIdle  = std::min( options.minIdle, options.maxSize );
+    options.reserved = std::min( options.reserved, options.maxSize - 1 );
+
+    auto count = options.minIdle;
+
+    LOG( logger, info, "Creating connection pool of {} (max {}) for {}", count, options.maxSize, endpoint );
+
+    for ( size_t index = slots.size( ); index > count; --index ) {
+      vacant.push( index - 1 );
+    }
+
+    std::vector< connection_t > pending;
+
+    for ( size_t index = 0; index < count; ++index ) {
+      pending.push_back( create( *binding ) );
+    }
+
+    auto results = connectAll( pending, steady_clock_t::now( ) + options.connectTimeout, options.hotStatements );
+
+    for ( size_t index = count; index > 0; --index ) {
+      if ( results[ index - 1 ].connected ) {
+        install( index - 1, pending[ index - 1 ], binding->epoch );
+        open.fetch_add( 1 );
+        metrics.opened.fetch_add( 1, std::memory_order_relaxed );
+        addConnectionIndex( index - 1 );
+      } else {
+        vacant.push( index - 1 );
+      }
+    }
+
+    if ( count && !open.load( ) ) {
+      throw DBException( fmt::format( "Unable to connect to {}", endpoint ) );
+    }
+
+    LOG( logger, info, "Connection pool of {} for {} completed", open.load( ), endpoint );
 
     LOG( logger,
          info,
@@ -39,66 +232,767 @@ namespace dbcpp {
          endpoint,
          checkPeriod.count( ) );
 
-    asyncTest = std::thread( [ this, checkPeriod, endpoint ]( ) -> void {
-      const auto SLEEP = std::chrono::microseconds( 125 );
-      auto       slept = std::chrono::microseconds( 0 );
-
-      for ( asyncTestRunning = true; asyncTestRunning; ) {
-        auto sleepFor = SLEEP;
-
-        /* Every check period, poll all the connections */
-        if ( slept >= checkPeriod ) {
-          LOG( logger,
-               debug,
-               "Check period of {:.3f}s expired for {}, checking connections", //
-               checkPeriod.count( ),
-               endpoint );
-
-          if ( !queue.empty( ) ) {
-            for ( size_t size = queue.size( ); size > 0; --size ) {
-              try {
-                getConnection( );
-              } catch ( ... ) {
-              }
-            }
-
-            slept = std::chrono::microseconds( 0 );
-          }
+    asyncTest = std::thread( &Pool::monitor, this, endpoint );
+  }
+
+  Pool::binding_t Pool::bind( const std::string &uri, uint64_t epoch ) {
+    std::shared_ptr< Binding > target( new Binding{ std::unique_ptr< Uri >( Uri::parse( uri ) ), { }, epoch } );
+    auto &                     parsed = *target->uri;
+
+    target->endpoint =
+      fmt::format( "{}://{}:{}/{}", parsed.scheme( ), parsed.host( ), parsed.port( ), parsed.resource( ) );
+
+    return target;
+  }
+
+  void Pool::monitor( std::string endpoint ) {
+    auto period    = std::chrono::duration_cast< steady_clock_t::duration >( options.checkPeriod );
+    auto nextCheck = steady_clock_t::now( ) + period;
+    auto epoch     = std::atomic_load( &binding )->epoch;
+
+    /* Leases are scanned at a quarter of the smallest lease threshold */
+    auto leasePeriod = steady_clock_t::duration::max( );
+
+    for ( auto &&threshold : { options.leakThreshold, options.reclaimAfter } ) {
+      if ( threshold.count( ) > 0 ) {
+        leasePeriod = std::min( leasePeriod, std::chrono::duration_cast< steady_clock_t::duration >( threshold ) / 4 );
+      }
+    }
+
+    auto nextLeases = leasePeriod == steady_clock_t::duration::max( ) ? steady_clock_t::time_point::max( )
+                                                                       : steady_clock_t::now( ) + leasePeriod;
+
+    std::unique_lock< std::mutex > guard( reconnectLock );
+
+    while ( asyncTestRunning ) {
+      auto                  now   = steady_clock_t::now( );
+      size_t                index = 0;
+      std::vector< size_t > indices;
+
+      while ( getReconnectIndex( index, now ) ) {
+        indices.push_back( index );
+      }
+
+      auto current    = std::atomic_load( &binding );
+      auto retirement = nextRetirement( );
+      auto expiry     = asyncExpiry.load( );
+      auto expiring   = expiry ? steady_clock_t::time_point( steady_clock_t::duration( expiry ) )
+                               : steady_clock_t::time_point::max( );
+
+      if ( indices.empty( ) && ( now < nextCheck ) && ( now < retirement ) && ( now < nextLeases ) &&
+           ( now < expiring ) && ( current->epoch == epoch ) ) {
+        auto wake = std::min( std::min( std::min( nextCheck, retirement ), nextLeases ), expiring );
+
+        if ( !reconnect.empty( ) ) {
+          wake = std::min( wake, reconnect.top( ).due );
         }
 
-        /* Rebuild failed connections */
-        if ( auto connection = getNextConnection( reconnect, reconnectLock ) ) {
-          LOG( logger, debug, "Initiating reconnection for pool resource of {}", endpoint );
+        /* Nothing due; sleep until something is, or a reconnect or retirement is scheduled */
+        monitorWake.wait_until( guard, wake );
+        continue;
+      }
 
-          auto start    = DBClock::now( );
-          auto rc       = connection->reconnect( );
-          auto end      = DBClock::now( );
-          auto duration = std::chrono::duration_cast< std::chrono::microseconds >( end - start );
+      guard.unlock( );
 
-          if ( rc ) { // It worked! Start using it
-            LOG( logger, debug, "Reconnection for pool resource of {}, successful", endpoint );
+      if ( current->epoch != epoch ) {
+        LOG( logger, info, "Connection pool for {} rebound to {}", endpoint, current->endpoint );
 
-            addConnection( connection );
-          } else { // Uhoh, schedule another attempt
-            LOG( logger, debug, "Reconnection for pool resource of {}, failed", endpoint );
+        epoch      = current->epoch;
+        endpoint   = current->endpoint;
+        retirement = now;
+        retireBinding( epoch );
+      }
 
-            addReconnect( connection );
-          }
+      if ( !indices.empty( ) ) {
+        reconnectIndices( indices, endpoint );
+      }
+
+      if ( now >= retirement ) {
+        replaceExpired( now, endpoint );
+      }
+
+      if ( now >= expiring ) {
+        expireAsync( now );
+      }
+
+      if ( now >= nextLeases ) {
+        checkLeases( now );
+        nextLeases = steady_clock_t::now( ) + leasePeriod;
+      }
+
+      /* Every check period, poll all the connections */
+      if ( now >= nextCheck ) {
+        LOG( logger,
+             debug,
+             "Check period of {:.3f}s expired for {}, checking connections", //
+             options.checkPeriod.count( ),
+             endpoint );
+
+        checkIdle( );
+
+        nextCheck = steady_clock_t::now( ) + period;
+      }
+
+      guard.lock( );
+    }
+  }
+
+  void Pool::retireBinding( uint64_t epoch ) {
+    for ( auto &&slot : slots ) {
+      /* Successors opened for the earlier binding are of no use */
+      if ( slot.replaced.load( ) && ( slot.successorOf.load( ) != epoch ) && slot.replaced.exchange( false ) ) {
+        if ( auto successor = std::atomic_exchange( &slot.successor, connection_t( ) ) ) {
+          close( successor );
+        }
+      }
+
+      auto bound = slot.epoch.load( );
+
+      if ( bound && ( bound != epoch ) ) {
+        slot.expires.store( 1 );
+      }
+    }
+  }
+
+  void Pool::replaceExpired( steady_clock_t::time_point now, const std::string &endpoint ) {
+    std::vector< size_t >       expired;
+    std::vector< connection_t > pending;
+    auto                        current = std::atomic_load( &binding );
+
+    /* Retry failures later, unless the slot's connection changed meanwhile */
+    auto postpone = [ this ]( Slot &slot ) {
+      auto expires = slot.expires.load( );
+      auto retry   = ( steady_clock_t::now( ) + options.retryBackoff ).time_since_epoch( ).count( );
+
+      if ( expires ) {
+        slot.expires.compare_exchange_strong( expires, retry );
+      }
+    };
+
+    for ( size_t index = 0; index < slots.size( ); ++index ) {
+      auto expires = slots[ index ].expires.load( );
+
+      if ( expires && ( expires <= now.time_since_epoch( ).count( ) ) && !slots[ index ].replaced.load( ) ) {
+        try {
+          pending.push_back( create( *current ) );
+          expired.push_back( index );
+        } catch ( std::exception &ex ) {
+          LOG( logger, debug, "Unable to create a pooled connection: {}", ex.what( ) );
+          postpone( slots[ index ] );
+        }
+      }
+    }
+
+    LOG( logger, debug, "Opening successors for {} expired pool resource(s) of {}", expired.size( ), endpoint );
+
+    auto results = connectAll( pending, steady_clock_t::now( ) + options.connectTimeout, options.hotStatements );
+
+    for ( size_t num = 0; num < expired.size( ); ++num ) {
+      auto &slot = slots[ expired[ num ] ];
+
+      if ( results[ num ].connected ) {
+        metrics.opened.fetch_add( 1, std::memory_order_relaxed );
+        slot.successorOf.store( current->epoch );
+        std::atomic_store( &slot.successor, pending[ num ] );
+        slot.replaced.store( true, std::memory_order_release );
+      } else {
+        postpone( slot );
+      }
+    }
+  }
+
+  void Pool::reconnectIndices( const std::vector< size_t > &broken, const std::string &endpoint ) {
+    std::vector< size_t >       indices;
+    std::vector< connection_t > pending;
+
+    /* A connection with a successor ready is simply replaced */
+    for ( auto &&index : broken ) {
+      if ( rotate( index ) ) {
+        slots[ index ].attempts = 0;
+        addConnectionIndex( index );
+      } else {
+        indices.push_back( index );
+      }
+    }
+
+    if ( indices.empty( ) ) {
+      return;
+    }
+
+    LOG( logger, debug, "Initiating reconnection for {} pool resource(s) of {}", indices.size( ), endpoint );
+
+    auto current = std::atomic_load( &binding );
+
+    for ( auto &&index : indices ) {
+      auto &slot = slots[ index ];
+
+      slot.connection->statementCache( ).clear( );
+      slot.connection->disconnect( );
+
+      /* Opened for an earlier binding; reconnect to the current one instead */
+      if ( slot.epoch.load( ) != current->epoch ) {
+        try {
+          slot.connection = create( *current );
+          slot.epoch.store( current->epoch );
+        } catch ( std::exception &ex ) {
+          LOG( logger, debug, "Unable to create a pooled connection: {}", ex.what( ) );
+        }
+      }
+
+      pending.push_back( slot.connection );
+    }
+
+    auto results = connectAll( pending, steady_clock_t::now( ) + options.connectTimeout, options.hotStatements );
+
+    for ( size_t num = 0; num < indices.size( ); ++num ) {
+      auto &slot = slots[ indices[ num ] ];
+
+      metrics.reconnectTime.record( results[ num ].elapsed );
+
+      if ( results[ num ].connected ) { // It worked! Start using it
+        LOG( logger, debug, "Reconnection for pool resource of {}, successful", endpoint );
+
+        metrics.reconnects.fetch_add( 1, std::memory_order_relaxed );
+        breaker.success( );
+        slot.attempts = 0;
+        scheduleRetirement( indices[ num ] );
+        addConnectionIndex( indices[ num ] );
+      } else { // Uhoh, schedule another attempt
+        auto delay = retryDelay( ++slot.attempts );
+
+        LOG( logger,
+             debug,
+             "Reconnection for pool resource of {}, failed {} time(s), retrying in {}ms",
+             endpoint,
+             slot.attempts,
+             std::chrono::duration_cast< std::chrono::milliseconds >( delay ).count( ) );
+
+        metrics.reconnectFailures.fetch_add( 1, std::memory_order_relaxed );
+        breaker.failure( );
+        addReconnectIndex( indices[ num ], delay );
+      }
+    }
+  }
+
+  void Pool::openIndex( size_t index ) {
+    try {
+      auto current    = std::atomic_load( &binding );
+      auto connection = connect( *current );
+
+      prepareHot( *connection, options.hotStatements );
+      install( index, std::move( connection ), current->epoch );
+      open.fetch_add( 1 );
+      metrics.opened.fetch_add( 1, std::memory_order_relaxed );
+    } catch ( std::exception &ex ) {
+      release( vacant, index );
+      throw DBException( fmt::format( "Unable to open a pooled connection: {}", ex.what( ) ) );
+    }
+
+    LOG( logger, debug, "Opened pooled connection #{}, {} open", index, open.load( ) );
+  }
+
+  bool Pool::checkout( size_t                     index,
+                       PoolOptions::Priority      priority,
+                       const char *               site,
+                       steady_clock_t::time_point start,
+                       Connection &               connection,
+                       bool &                     probe ) {
+    auto &slot = slots[ index ];
+
+    rotate( index );
+
+    if ( !slot.epoch.load( ) ) {
+      try {
+        openIndex( index );
+      } catch ( DBException & ) {
+        returnClaim( priority );
+        breaker.failure( probe );
+        throw;
+      }
+
+      breaker.success( probe );
+    } else {
+      auto validity = validate( slot, probe );
+
+      /* A failed test may only mean a stale connection; the probe carries on with the next slot */
+      if ( validity == INVALID ) {
+        metrics.validationFailures.fetch_add( 1, std::memory_order_relaxed );
+        addReconnectIndex( index );
+        returnClaim( priority );
+        return false;
+      }
+
+      if ( validity == TESTED ) {
+        breaker.success( probe );
+      }
+    }
+
+    auto waited = steady_clock_t::now( ) - start;
+
+    slot.connection->setAutoCommit( options.autoCommit );
+    metrics.waitTime.record( waited );
+    metrics.classWaitTime[ priority ].record( waited );
+    connection = lease( index, priority, site );
+    return true;
+  }
+
+  Connection Pool::getConnection( steady_clock_t::time_point deadline,
+                                  PoolOptions::Priority      priority,
+                                  const char *               site ) {
+    return acquire( nullptr, deadline, priority, site );
+  }
+
+  Connection Pool::getConnection( const std::string &        hint,
+                                  steady_clock_t::time_point deadline,
+                                  PoolOptions::Priority      priority,
+                                  const char *               site ) {
+    return acquire( &hint, deadline, priority, site );
+  }
+
+  Connection Pool::acquire( const std::string *        hint,
+                            steady_clock_t::time_point deadline,
+                            PoolOptions::Priority      priority,
+                            const char *               site ) {
+    auto       start = steady_clock_t::now( );
+    size_t     index = 0;
+    bool       probe = false;
+    Connection connection( nullptr );
+
+    admit( probe );
+
+    try {
+      while ( waitNextIndex( index, deadline, priority, hint ) ) {
+        if ( checkout( index, priority, site, start, connection, probe ) ) {
+          return connection;
+        }
+
+        if ( !probe ) {
+          admit( probe );
+        }
+      }
+    } catch ( PoolUnavailable & ) {
+      breaker.abandon( probe );
+      throw;
+    }
+
+    breaker.abandon( probe );
+    metrics.timeouts.fetch_add( 1, std::memory_order_relaxed );
+    metrics.classTimeouts[ priority ].fetch_add( 1, std::memory_order_relaxed );
+    throw DBException( "Timed out waiting for a pooled connection" );
+  }
+
+  bool Pool::tryGetConnection( Connection &connection, PoolOptions::Priority priority, const char *site ) {
+    auto   start = steady_clock_t::now( );
+    size_t index = 0;
+    bool   probe = false;
+
+    while ( !draining.load( ) && ( probe || breaker.admit( probe ) ) ) {
+      /* Parked checkouts are served first */
+      if ( ( waiting.load( ) > 0 ) || !takeIndex( index, priority ) ) {
+        breaker.abandon( probe );
+        return false;
+      }
+
+      if ( checkout( index, priority, site, start, connection, probe ) ) {
+        return true;
+      }
+    }
+
+    breaker.abandon( probe );
+    return false;
+  }
+
+  void Pool::submitAsync( std::shared_ptr< AsyncWaiter > waiter ) {
+    size_t       index = 0;
+    async_list_t ready;
+    bool         rejected = false;
+    bool         expiring = false;
+
+    if ( draining.load( ) ) {
+      metrics.rejections.fetch_add( 1, std::memory_order_relaxed );
+      breaker.abandon( waiter->probe );
+      failAsync( waiter, std::make_exception_ptr( PoolUnavailable( "Connection pool is draining" ) ) );
+      return;
+    }
+
+    if ( !waiter->probe && !breaker.admit( waiter->probe ) ) {
+      metrics.rejections.fetch_add( 1, std::memory_order_relaxed );
+      failAsync( waiter, std::make_exception_ptr( PoolUnavailable( "Connection pool circuit breaker is open" ) ) );
+      return;
+    }
+
+    if ( ( waiting.load( ) == 0 ) && takeIndex( index, waiter->priority ) ) {
+      waiter->index = index;
+      finishAsync( std::move( waiter ) );
+      return;
+    }
+
+    {
+      std::lock_guard< std::mutex > guard( queueLock );
+
+      /* A drain started since the check above has already failed the parked checkouts */
+      if ( draining.load( ) || ( options.maxWaiters && ( waiting.load( ) >= options.maxWaiters ) ) ) {
+        rejected = true;
+      } else {
+        auto deadline = waiter->deadline.time_since_epoch( ).count( );
+        auto earliest = asyncExpiry.load( );
+
+        /* Timed out by the monitor, woken below if this is the earliest deadline */
+        if ( ( waiter->deadline != steady_clock_t::time_point::max( ) ) && ( !earliest || ( deadline < earliest ) ) ) {
+          asyncExpiry.store( deadline );
+          expiring = true;
+        }
 
-          // Account for our time...
-          slept += duration;
-          sleepFor -= duration;
+        waiter->assigned = false;
+        waiter->enqueued = steady_clock_t::now( );
+        waiter->self     = waiter;
+        waiters[ waiter->priority ].push_back( waiter.get( ) );
+        waiting.fetch_add( 1 );
+        metrics.waits.fetch_add( 1, std::memory_order_relaxed );
 
-          if ( sleepFor <= std::chrono::microseconds( 0 ) ) {
+        dispatchWaiters( );
+        ready.swap( assigned );
+      }
+    }
+
+    if ( rejected ) {
+      auto reason = draining.load( ) ? "Connection pool is draining" : "Connection pool waiter limit reached";
+
+      metrics.rejections.fetch_add( 1, std::memory_order_relaxed );
+      breaker.abandon( waiter->probe );
+      failAsync( waiter, std::make_exception_ptr( PoolUnavailable( reason ) ) );
+      return;
+    }
+
+    if ( expiring ) {
+      wakeMonitor( );
+    }
+
+    completeAsync( ready );
+  }
+
+  void Pool::completeAsync( const async_list_t &ready ) {
+    for ( auto &&waiter : ready ) {
+      finishAsync( std::move( waiter->self ) );
+    }
+  }
+
+  void Pool::finishAsync( std::shared_ptr< AsyncWaiter > waiter ) {
+    Connection connection( nullptr );
+
+    try {
+      if ( !checkout( waiter->index, waiter->priority, waiter->site, waiter->start, connection, waiter->probe ) ) {
+        submitAsync( std::move( waiter ) ); // Failed validation; wait for another connection
+        return;
+      }
+    } catch ( DBException & ) {
+      failAsync( waiter, std::current_exception( ) );
+      return;
+    }
+
+    try {
+      waiter->handler( nullptr, std::move( connection ) );
+    } catch ( std::exception &ex ) {
+      LOG( logger, warn, "Asynchronous checkout handler failed: {}", ex.what( ) );
+    } catch ( ... ) {
+      LOG( logger, warn, "Asynchronous checkout handler failed" );
+    }
+  }
+
+  void Pool::failAsync( const std::shared_ptr< AsyncWaiter > &waiter, std::exception_ptr error ) {
+    try {
+      waiter->handler( error, Connection( nullptr ) );
+    } catch ( std::exception &ex ) {
+      LOG( logger, warn, "Asynchronous checkout handler failed: {}", ex.what( ) );
+    } catch ( ... ) {
+      LOG( logger, warn, "Asynchronous checkout handler failed" );
+    }
+  }
+
+  void Pool::expireAsync( steady_clock_t::time_point now ) {
+    std::vector< std::shared_ptr< AsyncWaiter > > expired;
+
+    {
+      std::lock_guard< std::mutex > guard( queueLock );
+      auto                          next = steady_clock_t::time_point::max( );
+
+      for ( auto &&parked : waiters ) {
+        for ( auto waiter = parked.begin( ); waiter != parked.end( ); ) {
+          if ( !( *waiter )->async ) {
+            ++waiter;
             continue;
           }
+
+          auto async = static_cast< AsyncWaiter * >( *waiter );
+
+          if ( async->deadline <= now ) {
+            expired.push_back( std::move( async->self ) );
+            waiter = parked.erase( waiter );
+            waiting.fetch_sub( 1 );
+          } else {
+            next = std::min( next, async->deadline );
+            ++waiter;
+          }
+        }
+      }
+
+      asyncExpiry.store( next == steady_clock_t::time_point::max( ) ? 0 : next.time_since_epoch( ).count( ) );
+    }
+
+    for ( auto &&waiter : expired ) {
+      breaker.abandon( waiter->probe );
+      metrics.timeouts.fetch_add( 1, std::memory_order_relaxed );
+      metrics.classTimeouts[ waiter->priority ].fetch_add( 1, std::memory_order_relaxed );
+      failAsync( waiter, std::make_exception_ptr( DBException( "Timed out waiting for a pooled connection" ) ) );
+    }
+  }
+
+  bool Pool::cancelAsync( AsyncWaiter *waiter ) {
+    std::shared_ptr< AsyncWaiter > cancelled;
+
+    {
+      std::lock_guard< std::mutex > guard( queueLock );
+
+      if ( waiter->assigned || !waiter->self ) {
+        return false;
+      }
+
+      auto &parked = waiters[ waiter->priority ];
+
+      parked.erase( std::find( parked.begin( ), parked.end( ), waiter ) );
+      waiting.fetch_sub( 1 );
+      cancelled = std::move( waiter->self );
+    }
+
+    breaker.abandon( cancelled->probe );
+    failAsync( cancelled, std::make_exception_ptr( DBException( "Connection checkout cancelled" ) ) );
+    return true;
+  }
+
+  bool Pool::drain( steady_clock_t::time_point deadline ) {
+    std::vector< std::shared_ptr< AsyncWaiter > > parked;
+    std::unique_lock< std::mutex >                guard( queueLock );
+
+    draining.store( true );
+
+    /* Blocked checkouts see the drain once woken; asynchronous ones are failed here */
+    for ( auto &&waiters : this->waiters ) {
+      for ( auto waiter = waiters.begin( ); waiter != waiters.end( ); ) {
+        if ( ( *waiter )->async ) {
+          parked.push_back( std::move( static_cast< AsyncWaiter * >( *waiter )->self ) );
+          waiter = waiters.erase( waiter );
+          waiting.fetch_sub( 1 );
+        } else {
+          ( *waiter )->ready.notify_one( );
+          ++waiter;
         }
+      }
+    }
+
+    guard.unlock( );
+
+    for ( auto &&waiter : parked ) {
+      breaker.abandon( waiter->probe );
+      failAsync( waiter, std::make_exception_ptr( PoolUnavailable( "Connection pool is draining" ) ) );
+    }
+
+    LOG( logger, info, "Draining connection pool, {} lease(s) outstanding", metrics.leased.load( ) );
+
+    guard.lock( );
+    return drained.wait_until( guard, deadline, [ this ]( ) { return metrics.leased.load( ) == 0; } );
+  }
+
+  void Pool::rebind( const std::string &uri ) {
+    {
+      std::lock_guard< std::mutex > guard( reconnectLock );
+      std::atomic_store( &binding, bind( uri, std::atomic_load( &binding )->epoch + 1 ) );
+    }
+
+    monitorWake.notify_one( );
+  }
+
+  void Pool::checkIdle( ) {
+    using listing_t = std::pair< steady_clock_t::rep, size_t >;
+
+    std::vector< listing_t >    listed;
+    std::vector< listing_t >    tested;
+    std::vector< connection_t > testing;
+    size_t                      index = 0;
+    auto                        now   = steady_clock_t::now( );
 
-        // Time for a nap till our next "shift"
-        std::this_thread::sleep_for( sleepFor );
-        slept += sleepFor;
+    /* The idle connections by check-in time, least recently used first, read off the slots */
+    for ( index = 0; index < slots.size( ); ++index ) {
+      auto since = slots[ index ].listed.load( );
+
+      if ( since > UNLISTED ) {
+        listed.emplace_back( since, index );
       }
-    } );
+    }
+
+    std::sort( listed.begin( ), listed.end( ) );
+
+    auto surplus = listed.size( ) > options.minIdle ? listed.size( ) - options.minIdle : 0;
+
+    /* Claim those idle past the timeout beyond minIdle, then the next idleTests, in place on the idle list */
+    for ( auto &&entry : listed ) {
+      auto idled   = now - steady_clock_t::time_point( steady_clock_t::duration( entry.first ) );
+      bool expired = surplus && ( idled >= options.idleTimeout );
+
+      if ( !expired && ( tested.size( ) >= options.idleTests ) ) {
+        break;
+      }
+
+      if ( !slots[ entry.second ].listed.compare_exchange_strong( entry.first, CLAIMED ) ) {
+        continue; // Taken meanwhile
+      }
+
+      if ( expired ) {
+        LOG( logger, debug, "Closing pooled connection #{}, idle past the timeout", entry.second );
+
+        --surplus;
+        vacate( entry.second );
+        settle( entry.second, CLOSED );
+      } else {
+        rotate( entry.second );
+        tested.push_back( entry );
+        testing.push_back( slots[ entry.second ].connection );
+      }
+    }
+
+    auto passed = testAll( testing, steady_clock_t::now( ) + options.connectTimeout );
+
+    for ( size_t num = 0; num < tested.size( ); ++num ) {
+      if ( passed[ num ].connected ) {
+        settle( tested[ num ].second, tested[ num ].first );
+      } else {
+        LOG( logger, debug, "Pooled connection #{} failed its idle test", tested[ num ].second );
+        settle( tested[ num ].second, BROKEN );
+      }
+    }
+
+    /* Top up the idle connections, concurrently */
+    std::vector< size_t >       opening;
+    std::vector< connection_t > pending;
+    auto                        current = std::atomic_load( &binding );
+
+    while ( ( idle( ) + opening.size( ) < options.minIdle ) && vacant.pop( index ) ) {
+      try {
+        pending.push_back( create( *current ) );
+        opening.push_back( index );
+      } catch ( std::exception &ex ) {
+        LOG( logger, debug, "Unable to create a pooled connection: {}", ex.what( ) );
+        release( vacant, index );
+        break;
+      }
+    }
+
+    auto results = connectAll( pending, steady_clock_t::now( ) + options.connectTimeout, options.hotStatements );
+
+    for ( size_t num = 0; num < opening.size( ); ++num ) {
+      if ( results[ num ].connected ) {
+        install( opening[ num ], pending[ num ], current->epoch );
+        open.fetch_add( 1 );
+        metrics.opened.fetch_add( 1, std::memory_order_relaxed );
+        addConnectionIndex( opening[ num ] );
+      } else {
+        LOG( logger, debug, "Unable to open pooled connection #{}", opening[ num ] );
+        release( vacant, opening[ num ] );
+      }
+    }
+  }
+
+  void Pool::checkLeases( steady_clock_t::time_point now ) {
+    for ( size_t index = 0; index < slots.size( ); ++index ) {
+      auto &slot       = slots[ index ];
+      auto  generation = slot.generation.load( );
+      auto  leased     = slot.leased.load( );
+
+      if ( !leased ) {
+        continue;
+      }
+
+      auto age  = now.time_since_epoch( ) - steady_clock_t::duration( leased );
+      auto site = slot.site.load( std::memory_order_relaxed );
+
+      if ( ( options.leakThreshold.count( ) > 0 ) && ( age >= options.leakThreshold ) &&
+           !slot.reported.exchange( true ) ) {
+        LOG( logger,
+             warn,
+             "Pooled connection #{} leased for {}ms by {}, possible leak",
+             index,
+             std::chrono::duration_cast< std::chrono::milliseconds >( age ).count( ),
+             site ? site : "an untagged caller" );
+
+        metrics.leaks.fetch_add( 1, std::memory_order_relaxed );
+      }
+
+      /* Reclaiming ends the lease; its holder keeps the connection, which the slot drops once reopened */
+      if ( ( options.reclaimAfter.count( ) > 0 ) && ( age >= options.reclaimAfter ) && endLease( index, generation ) ) {
+        LOG( logger,
+             warn,
+             "Reclaiming pooled connection #{} abandoned for {}ms by {}",
+             index,
+             std::chrono::duration_cast< std::chrono::milliseconds >( age ).count( ),
+             site ? site : "an untagged caller" );
+
+        metrics.reclaimed.fetch_add( 1, std::memory_order_relaxed );
+        addVacantIndex( index, true );
+      }
+    }
+  }
+
+  PoolStats Pool::stats( ) const {
+    PoolStats stats;
+
+    stats.checkouts          = metrics.checkouts.load( std::memory_order_relaxed );
+    stats.waits              = metrics.waits.load( std::memory_order_relaxed );
+    stats.timeouts           = metrics.timeouts.load( std::memory_order_relaxed );
+    stats.validationFailures = metrics.validationFailures.load( std::memory_order_relaxed );
+    stats.reconnects         = metrics.reconnects.load( std::memory_order_relaxed );
+    stats.reconnectFailures  = metrics.reconnectFailures.load( std::memory_order_relaxed );
+    stats.opened             = metrics.opened.load( std::memory_order_relaxed );
+    stats.closed             = metrics.closed.load( std::memory_order_relaxed );
+    stats.statementHits      = metrics.statementHits.load( std::memory_order_relaxed );
+    stats.statementMisses    = metrics.statementMisses.load( std::memory_order_relaxed );
+    stats.affinityHits       = metrics.affinityHits.load( std::memory_order_relaxed );
+    stats.affinityMisses     = metrics.affinityMisses.load( std::memory_order_relaxed );
+    stats.rejections         = metrics.rejections.load( std::memory_order_relaxed );
+    stats.retired            = metrics.retired.load( std::memory_order_relaxed );
+    stats.leaks              = metrics.leaks.load( std::memory_order_relaxed );
+    stats.reclaimed          = metrics.reclaimed.load( std::memory_order_relaxed );
+
+    stats.size    = open.load( );
+    stats.inUse   = metrics.leased.load( std::memory_order_relaxed );
+    stats.idle    = std::min( idle( ), stats.size );
+    stats.broken  = metrics.broken.load( std::memory_order_relaxed );
+    stats.waiting = waiting.load( );
+    stats.breaker = breaker.current( );
+
+    if ( options.leakThreshold.count( ) > 0 ) {
+      auto now = steady_clock_t::now( ).time_since_epoch( );
+
+      for ( size_t index = 0; index < slots.size( ); ++index ) {
+        auto leased = slots[ index ].leased.load( );
+        auto age    = now - steady_clock_t::duration( leased );
+
+        if ( leased && ( age >= options.leakThreshold ) ) {
+          stats.leases.push_back( LeaseInfo{ index,
+                                             std::chrono::duration_cast< std::chrono::microseconds >( age ),
+                                             slots[ index ].site.load( std::memory_order_relaxed ) } );
+        }
+      }
+    }
+
+    stats.waitTime      = metrics.waitTime.snapshot( );
+    stats.leaseTime     = metrics.leaseTime.snapshot( );
+    stats.reconnectTime = metrics.reconnectTime.snapshot( );
+
+    for ( size_t priority = 0; priority < PoolOptions::PRIORITIES; ++priority ) {
+      stats.classWaitTime.push_back( metrics.classWaitTime[ priority ].snapshot( ) );
+      stats.classTimeouts.push_back( metrics.classTimeouts[ priority ].load( std::memory_order_relaxed ) );
+    }
+
+    return stats;
   }
 
   /* Pool::connection_t Pool::connect( ) found in driver.cc */
@@ -5,6 +5,8 @@
 #include <catalog/pg_type_d.h>
 #include <cctype>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <endian.h>
 #include <functional>
 #include <iomanip>
@@ -97,26 +99,51 @@ namespace dbcpp {
       return UNKNOWN;
     }
 
-    static inline int32_t normalizeParameters( std::string query, std::string &output ) {
-      uint32_t bindNum    = 1;
-      bool     paramValid = true;
+/* Server log position visible to reads: replayed on a replica, inserted on a primary (PostgreSQL 10+) */
+#define LOG_POSITION_QUERY                                                                                             \
+  "SELECT CASE WHEN pg_is_in_recovery( ) THEN pg_last_wal_replay_lsn( ) ELSE pg_current_wal_insert_lsn( ) END::text"
+#define LOG_POSITION_VERSION 100000
+
+    /**
+     * @brief Parse a textual log sequence number, e.g. "16/B374D848"
+     * @param lsn log sequence number
+     * @return log position, 0 if malformed
+     */
+    static inline uint64_t logPosition( const char *lsn ) {
+      char *end  = nullptr;
+      auto  high = strtoull( lsn, &end, 16 );
+
+      if ( *end != '/' ) {
+        return 0;
+      }
+
+      return ( high << 32 ) | strtoull( end + 1, nullptr, 16 );
+    }
+
+    static inline int32_t normalizeParameters( const std::string &query, std::string &output ) {
+      uint32_t    bindNum    = 0;
+      bool        paramValid = true;
+      std::string normalized;
 
-      for ( std::string::size_type pos = 0; pos < query.length( ); ++pos ) {
-        char value = query.substr( pos, 1 ).c_str( )[ 0 ];
+      normalized.reserve( query.length( ) + 16 );
 
+      for ( auto value : query ) {
         if ( ( paramValid ) && ( value == '?' ) ) {
-          std::ostringstream ss;
-          ss << '$' << bindNum++;
-          query.replace( pos, 1, ss.str( ) );
-          ++pos;
-        } else if ( '\'' == value ) {
+          normalized += '$';
+          normalized += std::to_string( ++bindNum );
+          continue;
+        }
+
+        if ( '\'' == value ) {
           paramValid = !paramValid;
         }
+
+        normalized += value;
       }
 
-      output = query;
+      output = std::move( normalized );
 
-      return bindNum - 1;
+      return bindNum;
     }
 
     template < typename It >
@@ -215,17 +242,27 @@ namespace dbcpp {
       struct PSQLConnection : public interface::Connection, public std::enable_shared_from_this< PSQLConnection > {
         /* Members */
 
-        std::map< std::string, bool > prepared;
-        std::shared_ptr< PGconn >     pgcxn;
-        std::string                   uri;
-        bool                          integer_datetimes;
-        bool                          autoCommit;
+        std::map< std::string, bool >                prepared;
+        std::map< std::string, std::vector< Oid > > inferred; /**< Parameter types of pre-prepared statements */
+        std::map< std::string, std::string >         session;  /**< Session parameters set, by name */
+        std::map< std::string, std::string >         durable;  /**< Session parameters as of the last commit */
+        std::map< std::string, std::string >         changes;  /**< Session parameters to set with the next statement */
+        std::shared_ptr< PGconn >                    pgcxn;
+        std::string                                  uri;
+        bool                                         integer_datetimes;
+        bool                                         autoCommit;
+        uint64_t                                     committed;
+        bool                                         tracking;  /**< Commit positions captured */
+        bool                                         beginning; /**< BEGIN sent by connectPoll( ), not yet done */
 
         /* Implemented Interface */
         explicit PSQLConnection( Uri *const uri )
           : uri( uri->toString( ).replace( 0, 4, "postgres" ) )
           , integer_datetimes( false )
-          , autoCommit( false ) {}
+          , autoCommit( false )
+          , committed( 0 )
+          , tracking( false )
+          , beginning( false ) {}
 
         DBStatement createStatement( std::string query ) override {
           auto binds = normalizeParameters( query, query );
@@ -237,13 +274,7 @@ namespace dbcpp {
           pgcxn.reset( PQconnectdb( uri.c_str( ) ), PQfinish );
 
           if ( CONNECTION_OK == PQstatus( pgcxn.get( ) ) ) {
-            integer_datetimes = strcmp( PQparameterStatus( pgcxn.get( ), "integer_datetimes" ) ?: "null", "on" ) == 0;
-            PQsetErrorVerbosity( pgcxn.get( ), PQERRORS_VERBOSE );
-
-            LOG( logger, debug, "Successfully connected to {}", uri );
-            LOG(
-              logger, trace, "Connection to {} does{} have integer date times", uri, integer_datetimes ? "" : " not" );
-
+            connected( );
             begin( );
             return true;
           }
@@ -251,31 +282,431 @@ namespace dbcpp {
           return false;
         }
 
+        ConnectState connectStart( ) override {
+          beginning = false;
+          prepared.clear( );
+          inferred.clear( );
+          session.clear( );
+          durable.clear( );
+          changes.clear( );
+          pgcxn.reset( PQconnectStart( uri.c_str( ) ), PQfinish );
+
+          if ( !pgcxn || ( CONNECTION_BAD == PQstatus( pgcxn.get( ) ) ) ) {
+            LOG( logger, debug, "Unable to start connecting to {}", uri );
+            return CONNECT_FAILED;
+          }
+
+          /* Per libpq, start as if PQconnectPoll returned PGRES_POLLING_WRITING */
+          return CONNECT_WRITING;
+        }
+
+        ConnectState connectPoll( ) override {
+          if ( !pgcxn ) {
+            return CONNECT_FAILED;
+          }
+
+          if ( beginning ) {
+            return beginPoll( );
+          }
+
+          switch ( PQconnectPoll( pgcxn.get( ) ) ) {
+            case PGRES_POLLING_READING:
+              return CONNECT_READING;
+            case PGRES_POLLING_WRITING:
+              return CONNECT_WRITING;
+            case PGRES_POLLING_OK: {
+              connected( );
+
+              /* Open the first transaction without blocking the other connections polled alongside */
+              if ( !PQsendQuery( pgcxn.get( ), "BEGIN" ) ) {
+                LOG( logger, debug, "Unable to begin a transaction on {}: {}", uri, PQerrorMessage( pgcxn.get( ) ) );
+                return CONNECT_FAILED;
+              }
+
+              beginning = true;
+              return beginPoll( );
+            }
+            default:
+              LOG( logger, debug, "Connecting to {} failed: {}", uri, PQerrorMessage( pgcxn.get( ) ) );
+              return CONNECT_FAILED;
+          }
+        }
+
+        int socket( ) const override { return pgcxn ? PQsocket( pgcxn.get( ) ) : -1; }
+
+        /**
+         * @brief Advance the transaction begun by a non-blocking connection establishment
+         * @return connection state
+         */
+        ConnectState beginPoll( ) {
+          bool      began = true;
+          PGresult *result;
+
+          if ( !PQconsumeInput( pgcxn.get( ) ) ) {
+            LOG( logger, debug, "Unable to begin a transaction on {}: {}", uri, PQerrorMessage( pgcxn.get( ) ) );
+            return CONNECT_FAILED;
+          }
+
+          if ( PQisBusy( pgcxn.get( ) ) ) {
+            return CONNECT_READING;
+          }
+
+          beginning = false;
+
+          while ( ( result = PQgetResult( pgcxn.get( ) ) ) != nullptr ) {
+            began = began && ( PQresultStatus( result ) == PGRES_COMMAND_OK );
+            PQclear( result );
+          }
+
+          return began ? CONNECT_OK : CONNECT_FAILED;
+        }
+
+        /**
+         * @brief Complete the session setup of a newly established connection
+         */
+        void connected( ) {
+          integer_datetimes = strcmp( PQparameterStatus( pgcxn.get( ), "integer_datetimes" ) ?: "null", "on" ) == 0;
+          PQsetErrorVerbosity( pgcxn.get( ), PQERRORS_VERBOSE );
+
+          LOG( logger, debug, "Successfully connected to {}", uri );
+          LOG( logger, trace, "Connection to {} does{} have integer date times", uri, integer_datetimes ? "" : " not" );
+        }
+
         void setAutoCommit( bool ac ) override {
           LOG( logger, trace, "{} auto commit", ac ? "Enabling" : "Disabling" );
           autoCommit = ac;
         }
 
         void commit( ) override {
+          if ( tracking && ( PQserverVersion( pgcxn.get( ) ) >= LOG_POSITION_VERSION ) ) {
+            /* Commit, begin the next transaction and read the commit's log position in one round trip */
+            auto result = PQexec( pgcxn.get( ), "COMMIT; BEGIN; " LOG_POSITION_QUERY );
+
+            PG_RESULT_PROCESS( result, this, "Error encountered while committing" );
+
+            if ( ( PQntuples( result ) == 1 ) && !PQgetisnull( result, 0, 0 ) ) {
+              committed = logPosition( PQgetvalue( result, 0, 0 ) );
+            }
+
+            durable = session;
+            PQclear( result );
+            return;
+          }
+
+          std::map< std::string, std::string > requested;
+
+          /* Parameters not yet sent are left to the next statement, not sent with the COMMIT */
+          requested.swap( changes );
+
           try {
             Statement statement = createStatement( "COMMIT" );
             statement.execute( );
+            durable = session;
             begin( );
           } catch ( DBException &ex ) {
             begin( );
+            changes.swap( requested );
             throw ex;
           }
+
+          changes.swap( requested );
+        }
+
+        /**
+         * @brief Prepare statements in one pipelined round trip, caching them
+         *
+         * The parameter types are left to the server, and recorded; a statement bound with
+         * other types is prepared again on its first execution
+         * @param queries query strings
+         * @return error message, by query failing to prepare
+         */
+        std::map< std::string, std::string > prepareStatements( const std::vector< std::string > &queries ) override {
+          std::vector< std::shared_ptr< PSQLStatement > > pending;
+          std::map< std::string, std::string >            failed;
+
+          for ( auto &&query : queries ) {
+            auto statement = std::static_pointer_cast< PSQLStatement >( prepareStatement( query ) );
+
+            if ( !prepared[ statement->id ] ) {
+              pending.push_back( std::move( statement ) );
+            }
+          }
+
+#ifdef LIBPQ_HAS_PIPELINING
+          /* A failed prepare aborts the transaction and the rest of the pipeline, which are sent again */
+          while ( !pending.empty( ) && PQenterPipelineMode( pgcxn.get( ) ) ) {
+            std::vector< std::shared_ptr< PSQLStatement > > aborted;
+            bool                                            failure = false;
+
+            LOG( logger, trace, "Preparing {} statement(s) in one pipeline", pending.size( ) );
+
+            for ( auto &&statement : pending ) {
+              PQsendPrepare( pgcxn.get( ), statement->id.c_str( ), statement->query.c_str( ), 0, nullptr );
+              PQsendDescribePrepared( pgcxn.get( ), statement->id.c_str( ) );
+            }
+
+            PQpipelineSync( pgcxn.get( ) );
+
+            for ( auto &&statement : pending ) {
+              auto prepare  = pipelineResult( );
+              auto describe = pipelineResult( );
+              auto status   = PQresultStatus( prepare );
+
+              if ( status == PGRES_COMMAND_OK ) {
+                auto &types = inferred[ statement->id ];
+
+                prepared[ statement->id ] = true;
+
+                /* Left empty if not described, so it is prepared again with the bound types */
+                if ( PQresultStatus( describe ) == PGRES_COMMAND_OK ) {
+                  for ( int param = 0; param < PQnparams( describe ); ++param ) {
+                    types.push_back( PQparamtype( describe, param ) );
+                  }
+                }
+              } else if ( status == PGRES_PIPELINE_ABORTED ) {
+                aborted.push_back( statement );
+              } else {
+                failed[ statement->query ] = PQresultErrorMessage( prepare );
+                failure                    = true;
+              }
+
+              PQclear( prepare );
+              PQclear( describe );
+            }
+
+            pipelineEnd( );
+
+            if ( failure ) {
+              rollback( );
+            }
+
+            pending.swap( aborted );
+          }
+#endif
+
+          return failed;
+        }
+
+#ifdef LIBPQ_HAS_PIPELINING
+        /**
+         * @brief Get the result of the next command sent in pipeline mode
+         * @return command result, null if the connection failed
+         */
+        PGresult *pipelineResult( ) {
+          auto result = PQgetResult( pgcxn.get( ) );
+
+          /* Each command's result is followed by a null result */
+          if ( result != nullptr ) {
+            PQgetResult( pgcxn.get( ) );
+          }
+
+          return result;
+        }
+
+        /**
+         * @brief Consume the pipeline's results through its synchronization point, and leave
+         *        pipeline mode
+         */
+        void pipelineEnd( ) {
+          while ( auto result = PQgetResult( pgcxn.get( ) ) ) {
+            auto status = PQresultStatus( result );
+
+            PQclear( result );
+
+            if ( status == PGRES_PIPELINE_SYNC ) {
+              break;
+            }
+          }
+
+          PQexitPipelineMode( pgcxn.get( ) );
+        }
+#endif
+
+        bool setSessionParam( const std::string &name, const std::string &value ) override {
+          if ( sessionParam( name ) == value ) {
+            LOG( logger, trace, "Session parameter {} is already '{}'", name, value );
+            return true;
+          }
+
+          changes[ name ] = value;
+          return true;
+        }
+
+        std::string sessionParam( const std::string &name ) override {
+          auto change = changes.find( name );
+
+          if ( change != changes.end( ) ) {
+            return change->second;
+          }
+
+          /* Parameters the server reports as they change, e.g. TimeZone or application_name */
+          auto reported = pgcxn ? PQparameterStatus( pgcxn.get( ), name.c_str( ) ) : nullptr;
+
+          if ( reported != nullptr ) {
+            return reported;
+          }
+
+          auto set = session.find( name );
+
+          return set != session.end( ) ? set->second : std::string{ };
+        }
+
+        /**
+         * @brief Execute a prepared statement, setting the changed session parameters in the
+         *        same round trip (pipelined, where libpq supports it)
+         * @param id prepared statement name
+         * @param count parameter count
+         * @param values parameter values
+         * @param lengths parameter lengths
+         * @param formats parameter formats
+         * @return statement result, or the result of the session parameter change if it failed
+         */
+        PGresult *execPrepared( const std::string &id,
+                                int                count,
+                                const char *const *values,
+                                const int *        lengths,
+                                const int *        formats ) {
+          if ( changes.empty( ) ) {
+            return PQexecPrepared( pgcxn.get( ), id.c_str( ), count, values, lengths, formats, 1 );
+          }
+
+          std::vector< const char * > params;
+          auto                        query    = sessionQuery( params );
+          auto                        settings = &params[ 0 ];
+          auto                        sets     = static_cast< int >( params.size( ) );
+
+          LOG( logger, trace, "Setting {} session parameter(s) with the next statement", changes.size( ) );
+
+#ifdef LIBPQ_HAS_PIPELINING
+          if ( PQenterPipelineMode( pgcxn.get( ) ) ) {
+            PQsendQueryParams( pgcxn.get( ), query.c_str( ), sets, nullptr, settings, nullptr, nullptr, 0 );
+            PQsendQueryPrepared( pgcxn.get( ), id.c_str( ), count, values, lengths, formats, 1 );
+            PQpipelineSync( pgcxn.get( ) );
+
+            auto set    = pipelineResult( );
+            auto result = pipelineResult( );
+
+            pipelineEnd( );
+            return sessionChanged( set, result );
+          }
+#endif
+
+          auto set    = PQexecParams( pgcxn.get( ), query.c_str( ), sets, nullptr, settings, nullptr, nullptr, 0 );
+          auto result = PQresultStatus( set ) == PGRES_TUPLES_OK
+                          ? PQexecPrepared( pgcxn.get( ), id.c_str( ), count, values, lengths, formats, 1 )
+                          : nullptr;
+
+          return sessionChanged( set, result );
+        }
+
+        /**
+         * @brief Set the changed session parameters on their own, e.g. ahead of a batch
+         * @note Throws DBException
+         */
+        void applySession( ) {
+          if ( changes.empty( ) ) {
+            return;
+          }
+
+          std::vector< const char * > params;
+          auto                        query    = sessionQuery( params );
+          auto                        settings = &params[ 0 ];
+          auto                        sets     = static_cast< int >( params.size( ) );
+
+          auto set = PQexecParams( pgcxn.get( ), query.c_str( ), sets, nullptr, settings, nullptr, nullptr, 0 );
+
+          if ( set == nullptr ) {
+            DBCPP_EXCEPTION( "Error encountered while setting session parameters, connection reset" );
+          }
+
+          if ( auto failed = sessionChanged( set, nullptr ) ) {
+            PG_RESULT_PROCESS( failed, this, "Error encountered while setting session parameters" );
+            PQclear( failed );
+          }
+        }
+
+        /**
+         * @brief Build the query setting the changed session parameters
+         * @param params query parameters, set to the parameter names and values
+         * @return set_config( ) query
+         */
+        std::string sessionQuery( std::vector< const char * > &params ) const {
+          std::string query;
+
+          for ( auto &&change : changes ) {
+            query += query.empty( ) ? "SELECT " : ", ";
+            query += fmt::format( "set_config( ${}, ${}, false )", params.size( ) + 1, params.size( ) + 2 );
+            params.push_back( change.first.c_str( ) );
+            params.push_back( change.second.c_str( ) );
+          }
+
+          return query;
+        }
+
+        /**
+         * @brief Record the outcome of the session parameter changes sent with a statement
+         * @param set session parameter change result
+         * @param result statement result
+         * @return statement result, or the change result if the change failed
+         */
+        PGresult *sessionChanged( PGresult *set, PGresult *result ) {
+          bool applied = PQresultStatus( set ) == PGRES_TUPLES_OK;
+
+          if ( applied ) {
+            for ( auto &&change : changes ) {
+              session[ change.first ] = change.second;
+            }
+          }
+
+          changes.clear( );
+
+          PQclear( applied ? set : result );
+          return applied ? result : set;
+        }
+
+        uint64_t commitPosition( ) const override { return committed; }
+
+        bool trackCommitPosition( bool track ) override {
+          tracking = track;
+          return true;
+        }
+
+        uint64_t replayPosition( ) override {
+          uint64_t position = 0;
+
+          if ( !pgcxn || ( PQserverVersion( pgcxn.get( ) ) < LOG_POSITION_VERSION ) ) {
+            return position;
+          }
+
+          auto result = PQexec( pgcxn.get( ), LOG_POSITION_QUERY );
+
+          if ( ( PQresultStatus( result ) == PGRES_TUPLES_OK ) && ( PQntuples( result ) == 1 ) &&
+               !PQgetisnull( result, 0, 0 ) ) {
+            position = logPosition( PQgetvalue( result, 0, 0 ) );
+          }
+
+          PQclear( result );
+          return position;
         }
 
         void rollback( ) override {
+          std::map< std::string, std::string > requested;
+
+          /* Parameters set in the transaction revert with it; those not yet sent are kept */
+          requested.swap( changes );
+          session = durable;
+
           try {
             Statement statement = createStatement( "ROLLBACK" );
             statement.execute( );
             begin( );
           } catch ( DBException &ex ) {
             begin( );
+            changes.swap( requested );
             throw ex;
           }
+
+          changes.swap( requested );
         }
 
         void begin( ) {
@@ -285,7 +716,12 @@ namespace dbcpp {
 
         bool disconnect( ) override {
           LOG( logger, trace, "Disconnecting from {}", uri );
+          statementCache( ).clear( ); // Cached statements reference this connection; release them while it is open
           prepared.clear( );
+          inferred.clear( );
+          session.clear( );
+          durable.clear( );
+          changes.clear( );
           pgcxn.reset( );
           return true;
         }
@@ -295,6 +731,20 @@ namespace dbcpp {
           return connect( );
         }
 
+        bool alive( ) override {
+          if ( !pgcxn || ( PQstatus( pgcxn.get( ) ) != CONNECTION_OK ) ) {
+            return false;
+          }
+
+          switch ( PQtransactionStatus( pgcxn.get( ) ) ) {
+            case PQTRANS_IDLE:
+            case PQTRANS_INTRANS:
+              return true;
+            default: /* Command in progress, aborted transaction or lost connection */
+              return false;
+          }
+        }
+
         bool test( ) override {
           try {
             Statement statement = createStatement( "SELECT 1::int" );
@@ -307,6 +757,34 @@ namespace dbcpp {
           }
           return false;
         }
+
+        ConnectState testStart( ) override {
+          if ( !pgcxn || !PQsendQuery( pgcxn.get( ), "SELECT 1::int" ) ) {
+            return CONNECT_FAILED;
+          }
+
+          return testPoll( );
+        }
+
+        ConnectState testPoll( ) override {
+          bool      passed = true;
+          PGresult *result;
+
+          if ( !pgcxn || !PQconsumeInput( pgcxn.get( ) ) ) {
+            return CONNECT_FAILED;
+          }
+
+          if ( PQisBusy( pgcxn.get( ) ) ) {
+            return CONNECT_READING;
+          }
+
+          while ( ( result = PQgetResult( pgcxn.get( ) ) ) != nullptr ) {
+            passed = passed && ( PQresultStatus( result ) == PGRES_TUPLES_OK );
+            PQclear( result );
+          }
+
+          return passed ? CONNECT_OK : CONNECT_FAILED;
+        }
       };
 
       /* - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - */
@@ -323,6 +801,7 @@ namespace dbcpp {
             parameters->push_back( &value );
           }
           void operator( )( decltype( nullptr ) ) { parameters->push_back( nullptr ); }
+          void operator( )( const void *value ) { parameters->push_back( value ); }
           void operator( )( std::string &value ) { parameters->push_back( value.c_str( ) ); }
           void operator( )( std::vector< uint8_t > &value ) { parameters->push_back( &value[ 0 ] ); }
         };
@@ -336,11 +815,31 @@ namespace dbcpp {
                                 float,
                                 double,
                                 std::string,
-                                std::vector< uint8_t > >
-          AnyType;
+                                std::vector< uint8_t >,
+                                const void * >
+          AnyType; /**< Parameter value; a pointer for a borrowed value */
+
+        /** Host variable bound to a parameter */
+        struct Host {
+          HostType    type;
+          const void *address; /**< nullptr if not bound */
+          const bool *isNull;
+        };
+
+        /** Parameter set added to the batch */
+        struct Batched {
+          std::vector< AnyType > values;
+          std::vector< Oid >     types;
+          std::vector< int >     lengths;
+          std::vector< int >     formats;
+        };
 
         std::shared_ptr< PSQLConnection > connection;
+        std::vector< Batched >            batch;
         std::vector< AnyType >            paramValues;
+        std::vector< Host >               hosts;     /**< Bound host variables, by parameter */
+        std::vector< uint64_t >           wire;      /**< Encoded host variable values, a slot per parameter */
+        size_t                            hostCount; /**< Number of bound host variables */
         std::vector< const void * >       parameters;
         std::vector< Oid >                paramTypes;
         std::vector< int >                paramLengths;
@@ -353,16 +852,19 @@ namespace dbcpp {
         size_t                            binds;
         size_t                            fields;
         size_t                            rows;
+        bool                              declared;
 
         PSQLStatement( std::shared_ptr< PSQLConnection > _connection, std::string _query, size_t _binds )
           : connection( std::move( _connection ) )
+          , hostCount( 0 )
           , query( std::move( _query ) )
           , id( fmt::format( "stmt_{:X}", std::hash< std::string >{ }( query ) ) )
           , type( queryType( query ) )
           , result( nullptr )
           , binds( _binds )
           , fields( 0 )
-          , rows( 0 ) {
+          , rows( 0 )
+          , declared( false ) {
 
           if ( query.length( ) == 0 ) {
             DBCPP_EXCEPTION( "Query is empty" );
@@ -381,12 +883,18 @@ namespace dbcpp {
           paramFormats.resize( binds, 1 );
         }
 
-        ~PSQLStatement( ) {
+        ~PSQLStatement( ) { close( ); }
+
+        /**
+         * @brief Release the current result, closing the cursor of an executed select
+         */
+        void close( ) {
           if ( result != nullptr ) {
             PQclear( result );
+            result = nullptr;
           }
 
-          if ( type == SELECT ) {
+          if ( ( type == SELECT ) && declared ) {
             auto closeQuery = fmt::format( "CLOSE {}", id );
 
             LOG( logger, trace, "Performing cursor close for {}", id );
@@ -397,11 +905,28 @@ namespace dbcpp {
             result_trace( result, "Execute statement" );
 
             PQclear( result );
+            result   = nullptr;
+            declared = false;
           }
         }
 
+        void reset( ) override {
+          close( );
+          columnNames.clear( );
+          rows = 0;
+        }
+
+        /**
+         * @brief Check whether a parameter may be set: in range, and not bound to a host variable
+         * @param parameter parameter index (0 start)
+         * @return true if it may be set, false if not
+         */
+        bool settable( size_t parameter ) const {
+          return ( parameter < binds ) && ( hosts.empty( ) || !hosts[ parameter ].address );
+        }
+
         bool setParamNull( size_t parameter, FieldType type ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             const char *typeStr = "";
             Oid         oid     = VOIDOID;
 
@@ -459,7 +984,7 @@ namespace dbcpp {
         bool setParam( size_t parameter, uint64_t value ) override { return setParam( parameter, ( int64_t ) value ); }
 
         bool setParam( size_t parameter, dbcpp::interface::safebool value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to bool", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( bool ) value.val );
@@ -471,7 +996,7 @@ namespace dbcpp {
         }
 
         bool setParam( size_t parameter, int8_t value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to byte", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( int8_t ) value );
@@ -483,7 +1008,7 @@ namespace dbcpp {
         }
 
         bool setParam( size_t parameter, int16_t value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to short", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( int16_t ) htobe16( value ) );
@@ -495,7 +1020,7 @@ namespace dbcpp {
         }
 
         bool setParam( size_t parameter, int32_t value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to int", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( int32_t ) htobe32( value ) );
@@ -507,7 +1032,7 @@ namespace dbcpp {
         }
 
         bool setParam( size_t parameter, int64_t value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to long long", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( int64_t ) htobe64( value ) );
@@ -521,7 +1046,7 @@ namespace dbcpp {
         bool setParam( size_t parameter, float value ) override {
           int32_t val = *reinterpret_cast< int32_t * >( &value );
 
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to float", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( int32_t ) htobe32( val ) );
@@ -535,7 +1060,7 @@ namespace dbcpp {
         bool setParam( size_t parameter, double value ) override {
           int64_t val = *reinterpret_cast< int64_t * >( &value );
 
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to double", parameter + 1 );
 
             paramValues[ parameter ]  = AnyType( ( int64_t ) htobe64( val ) );
@@ -551,31 +1076,55 @@ namespace dbcpp {
         }
 
         bool setParam( size_t parameter, std::string value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to string", parameter + 1 );
 
-            paramValues[ parameter ]  = AnyType( value );
-            paramTypes[ parameter ]   = VARCHAROID;
             paramLengths[ parameter ] = value.size( );
+            paramValues[ parameter ]  = AnyType( std::move( value ) );
+            paramTypes[ parameter ]   = VARCHAROID;
+            return true;
+          }
+          return false;
+        }
+
+        bool setParam( size_t parameter, StringRef value ) override {
+          if ( settable( parameter ) ) {
+            LOG( logger, trace, "Set parameter #{} to borrowed string", parameter + 1 );
+
+            paramValues[ parameter ]  = AnyType( static_cast< const void * >( value.data ) );
+            paramTypes[ parameter ]   = VARCHAROID;
+            paramLengths[ parameter ] = value.size;
             return true;
           }
           return false;
         }
 
         bool setParam( size_t parameter, std::vector< uint8_t > value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to bytea", parameter + 1 );
 
-            paramValues[ parameter ]  = AnyType( value );
-            paramTypes[ parameter ]   = BYTEAOID;
             paramLengths[ parameter ] = value.size( );
+            paramValues[ parameter ]  = AnyType( std::move( value ) );
+            paramTypes[ parameter ]   = BYTEAOID;
+            return true;
+          }
+          return false;
+        }
+
+        bool setParam( size_t parameter, ByteRef value ) override {
+          if ( settable( parameter ) ) {
+            LOG( logger, trace, "Set parameter #{} to borrowed bytea", parameter + 1 );
+
+            paramValues[ parameter ]  = AnyType( static_cast< const void * >( value.data ) );
+            paramTypes[ parameter ]   = BYTEAOID;
+            paramLengths[ parameter ] = value.size;
             return true;
           }
           return false;
         }
 
         bool setParam( size_t parameter, DBTime value ) override {
-          if ( parameter < binds ) {
+          if ( settable( parameter ) ) {
             LOG( logger, trace, "Set parameter #{} to long long", parameter + 1 );
 
             if ( connection->integer_datetimes ) {
@@ -593,8 +1142,146 @@ namespace dbcpp {
           return false;
         }
 
+        bool bindParam( size_t parameter, HostType host, const void *address, const bool *isNull ) override {
+          /* Parameter type, per host type; unsigned types widen as in setParam( ) */
+          static const Oid oids[] = { BOOLOID, CHAROID, INT2OID,   INT2OID,   INT4OID,    INT4OID,  INT8OID,
+                                      INT8OID, INT8OID, FLOAT4OID, FLOAT8OID, VARCHAROID, BYTEAOID, TIMESTAMPOID };
+
+          if ( ( parameter >= binds ) || ( ( host == HOST_TIME ) && !connection->integer_datetimes ) ) {
+            return false;
+          }
+
+          LOG( logger, trace, "Bind parameter #{} to a host variable", parameter + 1 );
+
+          if ( hosts.empty( ) ) {
+            hosts.resize( binds, Host{ HOST_BOOL, nullptr, nullptr } );
+            wire.resize( binds );
+          }
+
+          hostCount += ( address ? 1 : 0 ) - ( hosts[ parameter ].address ? 1 : 0 );
+
+          hosts[ parameter ] = Host{ host, address, isNull };
+
+          if ( address ) {
+            paramTypes[ parameter ] = oids[ host ];
+          }
+
+          return true;
+        }
+
+        void unbindParams( ) override {
+          hosts.clear( );
+          wire.clear( );
+          hostCount = 0;
+        }
+
+        /**
+         * @brief Read a host variable, as a same sized unsigned type
+         * @param address host variable
+         * @return host variable bits
+         */
+        template < typename T >
+        static T load( const void *address ) {
+          T value;
+
+          memcpy( &value, address, sizeof( value ) );
+          return value;
+        }
+
+        /**
+         * @brief Store a value in a wire slot
+         * @param slot wire slot
+         * @param value value, in network byte order
+         * @return value length
+         */
+        template < typename T >
+        static int store( uint64_t &slot, T value ) {
+          memcpy( &slot, &value, sizeof( value ) );
+          return sizeof( value );
+        }
+
+        /**
+         * @brief Point the parameter array at the bound host variables' current values,
+         *        encoding the fixed size values into their wire slots
+         */
+        void encode( ) {
+          for ( size_t parameter = 0; parameter < hosts.size( ); ++parameter ) {
+            auto &host   = hosts[ parameter ];
+            auto &slot   = wire[ parameter ];
+            auto &length = paramLengths[ parameter ];
+
+            if ( !host.address ) {
+              continue;
+            }
+
+            if ( host.isNull && *host.isNull ) {
+              parameters[ parameter ] = nullptr;
+              length                  = 0;
+              continue;
+            }
+
+            parameters[ parameter ] = &slot;
+
+            switch ( host.type ) {
+              case HOST_BOOL:
+              case HOST_INT8: {
+                length = store( slot, load< uint8_t >( host.address ) );
+                break;
+              }
+              case HOST_UINT8: {
+                length = store( slot, htobe16( load< uint8_t >( host.address ) ) );
+                break;
+              }
+              case HOST_INT16: {
+                length = store( slot, htobe16( load< uint16_t >( host.address ) ) );
+                break;
+              }
+              case HOST_UINT16: {
+                length = store( slot, htobe32( load< uint16_t >( host.address ) ) );
+                break;
+              }
+              case HOST_INT32:
+              case HOST_FLOAT: {
+                length = store( slot, htobe32( load< uint32_t >( host.address ) ) );
+                break;
+              }
+              case HOST_UINT32: {
+                length = store( slot, htobe64( load< uint32_t >( host.address ) ) );
+                break;
+              }
+              case HOST_INT64:
+              case HOST_UINT64:
+              case HOST_DOUBLE: {
+                length = store( slot, htobe64( load< uint64_t >( host.address ) ) );
+                break;
+              }
+              case HOST_TIME: {
+                auto _time = static_cast< const DBTime * >( host.address )->time_since_epoch( );
+                auto micro = ( std::chrono::duration_cast< std::chrono::microseconds >( _time ) - PSQLEpoch ).count( );
+
+                length = store( slot, htobe64( micro ) );
+                break;
+              }
+              case HOST_STRING: {
+                auto value = static_cast< const std::string * >( host.address );
+
+                parameters[ parameter ] = value->c_str( );
+                length                  = value->size( );
+                break;
+              }
+              case HOST_VARBYTE: {
+                ByteRef value( *static_cast< const VarByte * >( host.address ) );
+
+                parameters[ parameter ] = value.data;
+                length                  = value.size;
+                break;
+              }
+            }
+          }
+        }
+
         void execute( ) override {
-          PQclear( result );
+          reset( ); // Executed again without new parameters, the cursor may still be open
 
 #if 0
           if ( paramTypes.empty( ) ) {
@@ -632,7 +1319,33 @@ namespace dbcpp {
           fields = PQnfields( result );
         }
 
-        void executePrepared( ) {
+        /**
+         * @brief Prepare the statement on the connection, with the bound parameter types,
+         *        unless already prepared
+         * @note Throws DBException
+         */
+        void prepare( ) {
+          auto inferred = connection->inferred.find( id );
+
+          /* Pre-prepared with the server's choice of parameter types; replaced if bound otherwise */
+          if ( inferred != connection->inferred.end( ) ) {
+            if ( inferred->second != paramTypes ) {
+              auto deallocate = fmt::format( "DEALLOCATE {}", id );
+
+              LOG( logger, trace, "Replacing statement {} prepared with other parameter types", id );
+
+              auto released = PQexec( connection->pgcxn.get( ), deallocate.c_str( ) );
+
+              PG_RESULT_PROCESS( released, connection, "Error encountered while deallocating statement" );
+
+              PQclear( released );
+
+              connection->prepared[ id ] = false;
+            }
+
+            connection->inferred.erase( inferred );
+          }
+
           if ( !connection->prepared[ id ] ) {
             LOG( logger, trace, "Preparing query {}", query );
 
@@ -655,6 +1368,38 @@ namespace dbcpp {
           } else {
             LOG( logger, trace, "Statement already prepared" );
           }
+        }
+
+        /**
+         * @brief Point the parameter array at a parameter set's values
+         * @param values parameter values
+         */
+        void point( std::vector< AnyType > &values ) {
+          AnyTypeVisitor visitor( &parameters );
+          parameters.clear( );
+          std::for_each( values.begin( ), values.end( ), boost::apply_visitor( visitor ) );
+        }
+
+        /**
+         * @brief Point the parameter array at the set values and bound host variables
+         */
+        void gather( ) {
+          if ( hostCount < binds ) {
+            point( paramValues );
+          } else {
+            parameters.resize( binds ); // Every value comes from a host variable
+          }
+
+          encode( );
+        }
+
+        /**
+         * @brief Execute the prepared statement
+         * @param current read the bound host variables' current values, rather than the
+         *                values already set
+         */
+        void executePrepared( bool current = true ) {
+          prepare( );
 
           /*
           if ( !cursor ) {
@@ -674,19 +1419,17 @@ namespace dbcpp {
           PQclear( result );
           */
 
-          {
-            AnyTypeVisitor visitor( &parameters );
-            parameters.clear( );
-            std::for_each( paramValues.begin( ), paramValues.end( ), boost::apply_visitor( visitor ) );
+          if ( current ) {
+            gather( );
+          } else {
+            point( paramValues );
           }
 
-          result = PQexecPrepared( connection->pgcxn.get( ),
-                                   id.c_str( ),
-                                   parameters.size( ),
-                                   ( const char *const * ) &parameters[ 0 ],
-                                   &paramLengths[ 0 ],
-                                   &paramFormats[ 0 ],
-                                   1 );
+          result = connection->execPrepared( id,
+                                             parameters.size( ),
+                                             ( const char *const * ) &parameters[ 0 ],
+                                             &paramLengths[ 0 ],
+                                             &paramFormats[ 0 ] );
 
           if ( result == nullptr ) {
             DBCPP_EXCEPTION( "Error encountered while executing statement, connection reset" );
@@ -696,6 +1439,8 @@ namespace dbcpp {
 
           PG_RESULT_PROCESS( result, connection, "Error encountered while executing prepared statement" );
 
+          declared = type == SELECT;
+
           fetch( );
         }
 
@@ -737,11 +1482,189 @@ namespace dbcpp {
           return rows > 0;
         }
 
+        /**
+         * @brief Get the number of rows affected by a modification query
+         * @param result query result
+         * @return affected rows
+         */
+        static int affected( PGresult *result ) {
+          const char *tuples = PQcmdTuples( result );
+          return *tuples ? std::stol( tuples ) : 0;
+        }
+
         int executeUpdate( ) override {
           execute( );
 
-          const char *tuples = PQcmdTuples( result );
-          return *tuples ? std::stol( tuples ) : 0;
+          return affected( result );
+        }
+
+        void addBatch( ) override {
+          if ( !hostCount ) {
+            batch.push_back( Batched{ paramValues, paramTypes, paramLengths, paramFormats } );
+            return;
+          }
+
+          /* The host variables change before the next set is added: keep their current values */
+          gather( );
+
+          Batched row{ paramValues, paramTypes, paramLengths, paramFormats };
+
+          for ( size_t parameter = 0; parameter < hosts.size( ); ++parameter ) {
+            auto value = static_cast< const char * >( parameters[ parameter ] );
+
+            if ( !hosts[ parameter ].address ) {
+              continue;
+            }
+
+            if ( value ) {
+              row.values[ parameter ] = AnyType( std::string( value, paramLengths[ parameter ] ) );
+            } else {
+              row.values[ parameter ] = AnyType( nullptr );
+            }
+          }
+
+          batch.push_back( std::move( row ) );
+        }
+
+        /**
+         * @brief Execute parameter sets in one pipeline
+         * @param rows parameter sets
+         * @param counts number of affected rows, per parameter set
+         * @return true if executed, false if pipeline mode is not available
+         * @note Throws DBException
+         */
+        bool executePipelined( std::vector< Batched > &rows, std::vector< int > &counts ) {
+#ifdef LIBPQ_HAS_PIPELINING
+          PGresult *failure = nullptr;
+          bool      failed  = false;
+
+          if ( !PQenterPipelineMode( connection->pgcxn.get( ) ) ) {
+            return false;
+          }
+
+          LOG( logger, trace, "Executing a batch of {} parameter set(s) in one pipeline", rows.size( ) );
+
+          for ( auto &&row : rows ) {
+            point( row.values );
+
+            PQsendQueryPrepared( connection->pgcxn.get( ),
+                                 id.c_str( ),
+                                 parameters.size( ),
+                                 ( const char *const * ) &parameters[ 0 ],
+                                 &row.lengths[ 0 ],
+                                 &row.formats[ 0 ],
+                                 1 );
+          }
+
+          PQpipelineSync( connection->pgcxn.get( ) );
+
+          /* The first failure aborts the rest of the pipeline */
+          for ( size_t num = 0; num < rows.size( ); ++num ) {
+            auto executed = connection->pipelineResult( );
+            auto status   = PQresultStatus( executed );
+
+            if ( ( status == PGRES_COMMAND_OK ) || ( status == PGRES_TUPLES_OK ) ) {
+              counts.push_back( affected( executed ) );
+              PQclear( executed );
+            } else if ( !failed ) {
+              failure = executed;
+              failed  = true;
+            } else {
+              PQclear( executed );
+            }
+          }
+
+          connection->pipelineEnd( );
+
+          if ( failed ) {
+            if ( failure == nullptr ) {
+              DBCPP_EXCEPTION( "Error encountered while executing batch, connection reset" );
+            }
+
+            PG_RESULT_PROCESS( failure, connection, "Error encountered while executing batch" );
+            PQclear( failure );
+            DBCPP_EXCEPTION( "Batch execution was aborted" );
+          }
+
+          return true;
+#else
+          return false;
+#endif
+        }
+
+        /**
+         * @brief Get the parameter types a batch is prepared with: per parameter, the type of
+         *        the sets with a value for it, as a null fits any type
+         * @param rows parameter sets
+         * @return parameter types
+         * @note Throws DBException if the sets bind a parameter with different types
+         */
+        static std::vector< Oid > batchTypes( const std::vector< Batched > &rows ) {
+          auto                types = rows.front( ).types;
+          std::vector< bool > typed( types.size( ), false );
+
+          for ( auto &&row : rows ) {
+            for ( size_t parameter = 0; parameter < types.size( ); ++parameter ) {
+              if ( row.values[ parameter ].which( ) == 0 ) {
+                continue; // Null
+              }
+
+              if ( !typed[ parameter ] ) {
+                types[ parameter ] = row.types[ parameter ];
+                typed[ parameter ] = true;
+              } else if ( row.types[ parameter ] != types[ parameter ] ) {
+                DBCPP_EXCEPTION( "Batched parameter #{} is bound with different types", parameter + 1 );
+              }
+            }
+          }
+
+          return types;
+        }
+
+        /**
+         * @brief Execute the batch in one pipeline, prepared with the parameter sets' types,
+         *        committing once at the end in auto commit mode
+         * @return number of affected rows, per parameter set
+         * @note Throws DBException, without executing any set, if the sets bind a parameter
+         *       with different types
+         */
+        std::vector< int > executeBatch( ) override {
+          std::vector< Batched > rows;
+          std::vector< int >     counts;
+
+          rows.swap( batch );
+
+          if ( rows.empty( ) ) {
+            return counts;
+          }
+
+          if ( type == SELECT ) {
+            DBCPP_EXCEPTION( "Only modification queries can be batched" );
+          }
+
+          PQclear( result );
+          result     = nullptr;
+          paramTypes = batchTypes( rows );
+
+          prepare( );
+          connection->applySession( );
+
+          if ( !executePipelined( rows, counts ) ) {
+            for ( auto &&row : rows ) {
+              paramValues  = std::move( row.values );
+              paramLengths = std::move( row.lengths );
+              paramFormats = std::move( row.formats );
+
+              executePrepared( false );
+              counts.push_back( affected( result ) );
+            }
+          }
+
+          if ( connection->autoCommit ) {
+            connection->commit( );
+          }
+
+          return counts;
         }
 
         DBResultSet getResults( ) override {
@@ -1068,9 +1991,22 @@ namespace dbcpp {
       /* - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - * - */
 
       struct PSQLResultSet : public interface::ResultSet, public std::enable_shared_from_this< PSQLResultSet > {
+        /** Writes a binary column value into a bound variable */
+        using Decoder = void ( * )( const char *value, int length, void *target );
+
+        /** Column bound to a variable */
+        struct Bound {
+          size_t   field;
+          Decoder  decode; /**< nullptr to go through the field's get( ) */
+          HostType type;
+          void *   target;
+          bool *   isNull;
+        };
+
         std::vector< std::unique_ptr< PSQLField > > columns;
         std::shared_ptr< PSQLStatement >            stmt;
         size_t                                      current;
+        std::vector< Bound >                        bound; /**< Bound columns */
 
         PSQLResultSet( std::shared_ptr< PSQLStatement > _stmt )
           : stmt( std::move( _stmt ) )
@@ -1142,7 +2078,188 @@ namespace dbcpp {
               current = 0;
             }
           }
-          return current < rows( );
+
+          if ( current >= rows( ) ) {
+            return false;
+          }
+
+          decodeRow( );
+          return true;
+        }
+
+        static int8_t  toHost( int8_t wire ) { return wire; }
+        static int16_t toHost( int16_t wire ) { return be16toh( wire ); }
+        static int32_t toHost( int32_t wire ) { return be32toh( wire ); }
+        static int64_t toHost( int64_t wire ) { return be64toh( wire ); }
+
+        /**
+         * @brief Decode a binary integer column value
+         * @param value column value, W in network byte order
+         * @param target T variable
+         */
+        template < typename T, typename W >
+        static void decodeInteger( const char *value, int, void *target ) {
+          W wire;
+
+          memcpy( &wire, value, sizeof( wire ) );
+          *static_cast< T * >( target ) = static_cast< T >( toHost( wire ) );
+        }
+
+        /**
+         * @brief Decode a binary floating point column value
+         * @param value column value, F with the bits of W in network byte order
+         * @param target T variable
+         */
+        template < typename T, typename F, typename W >
+        static void decodeReal( const char *value, int, void *target ) {
+          W wire;
+          F real;
+
+          memcpy( &wire, value, sizeof( wire ) );
+          wire = toHost( wire );
+          memcpy( &real, &wire, sizeof( real ) );
+          *static_cast< T * >( target ) = static_cast< T >( real );
+        }
+
+        static void decodeText( const char *value, int length, void *target ) {
+          static_cast< std::string * >( target )->assign( value, length );
+        }
+
+        static void decodeBytes( const char *value, int length, void *target ) {
+          auto bytes = reinterpret_cast< const uint8_t * >( value );
+
+          static_cast< VarByte * >( target )->assign( bytes, bytes + length );
+        }
+
+        static void decodeTimestamp( const char *value, int length, void *target ) {
+          int64_t micro = 0;
+
+          decodeInteger< int64_t, int64_t >( value, length, &micro );
+          *static_cast< DBTime * >( target ) = DBTime( std::chrono::microseconds( micro ) + PSQLEpoch );
+        }
+
+        /**
+         * @brief Choose the decoder of a numeric column into a T variable
+         * @param oid column type
+         * @return decoder, nullptr if the column is not numeric
+         */
+        template < typename T >
+        static Decoder numericDecoder( Oid oid ) {
+          switch ( oid ) {
+            case BOOLOID:
+            case CHAROID:
+              return &decodeInteger< T, int8_t >;
+            case INT2OID:
+              return &decodeInteger< T, int16_t >;
+            case INT4OID:
+              return &decodeInteger< T, int32_t >;
+            case INT8OID:
+              return &decodeInteger< T, int64_t >;
+            case FLOAT4OID:
+              return &decodeReal< T, float, int32_t >;
+            case FLOAT8OID:
+              return &decodeReal< T, double, int64_t >;
+            default:
+              return nullptr;
+          }
+        }
+
+        /**
+         * @brief Choose the decoder of a column into a variable; columns without a direct
+         *        decoding go through their field's get( )
+         * @param field column number
+         * @param type variable type
+         * @return decoder, nullptr for none
+         */
+        Decoder decoder( size_t field, HostType type ) const {
+          auto oid = PQftype( stmt->result, field );
+
+          if ( !PQbinaryTuples( stmt->result ) ) {
+            return nullptr;
+          }
+
+          switch ( type ) {
+            case HOST_BOOL:
+              return numericDecoder< bool >( oid );
+            case HOST_INT8:
+              return numericDecoder< int8_t >( oid );
+            case HOST_UINT8:
+              return numericDecoder< uint8_t >( oid );
+            case HOST_INT16:
+              return numericDecoder< int16_t >( oid );
+            case HOST_UINT16:
+              return numericDecoder< uint16_t >( oid );
+            case HOST_INT32:
+              return numericDecoder< int32_t >( oid );
+            case HOST_UINT32:
+              return numericDecoder< uint32_t >( oid );
+            case HOST_INT64:
+              return numericDecoder< int64_t >( oid );
+            case HOST_UINT64:
+              return numericDecoder< uint64_t >( oid );
+            case HOST_FLOAT:
+              return numericDecoder< float >( oid );
+            case HOST_DOUBLE:
+              return numericDecoder< double >( oid );
+            case HOST_STRING: {
+              auto text = ( oid == VARCHAROID ) || ( oid == TEXTOID ) || ( oid == NAMEOID );
+
+              return text ? &decodeText : nullptr;
+            }
+            case HOST_VARBYTE:
+              return oid == BYTEAOID ? &decodeBytes : nullptr;
+            case HOST_TIME: {
+              auto timestamp = ( oid == TIMESTAMPOID ) || ( oid == TIMESTAMPTZOID );
+
+              return ( timestamp && stmt->connection->integer_datetimes ) ? &decodeTimestamp : nullptr;
+            }
+          }
+
+          return nullptr;
+        }
+
+        bool bindColumn( size_t field, HostType type, void *target, bool *isNull ) override {
+          if ( field >= columns.size( ) ) {
+            return false;
+          }
+
+          auto rebound = std::find_if( bound.begin( ), bound.end( ), [ field ]( const Bound &column ) {
+            return column.field == field;
+          } );
+
+          if ( rebound != bound.end( ) ) {
+            bound.erase( rebound );
+          }
+
+          bound.push_back( Bound{ field, decoder( field, type ), type, target, isNull } );
+          return true;
+        }
+
+        void unbindColumns( ) override { bound.clear( ); }
+
+        /**
+         * @brief Set the bound variables from the current row
+         */
+        void decodeRow( ) {
+          for ( auto &&column : bound ) {
+            auto null = PQgetisnull( stmt->result, current, column.field ) != 0;
+
+            if ( column.isNull ) {
+              *column.isNull = null;
+            }
+
+            if ( null ) {
+              continue;
+            }
+
+            if ( column.decode ) {
+              column.decode( PQgetvalue( stmt->result, current, column.field ),
+                             PQgetlength( stmt->result, current, column.field ),
+                             column.target );
+            } else {
+              columns[ column.field ]->get( column.type, column.target );
+            }
+          }
         }
 
         DBField get( size_t field ) const override {
@@ -0,0 +1,118 @@
+#include "dbc++/dbcpp.hh"
+#include <algorithm>
+#include <fstream>
+#include <sched.h>
+#include <sstream>
+
+namespace dbcpp {
+  namespace {
+    /**
+     * @brief Map each CPU to its NUMA node, per the kernel's node cpu lists
+     * @param cpus CPU count
+     * @param nodes NUMA node count, 1 if the topology is not available
+     * @return node, per CPU
+     */
+    std::vector< size_t > cpuNodes( size_t cpus, size_t &nodes ) {
+      std::vector< size_t > node( cpus, 0 );
+
+      for ( nodes = 0;; ++nodes ) {
+        std::ifstream cpulist( "/sys/devices/system/node/node" + std::to_string( nodes ) + "/cpulist" );
+        std::string   range;
+
+        if ( !cpulist ) {
+          break;
+        }
+
+        /* e.g. "0-3,8-11" */
+        while ( std::getline( cpulist, range, ',' ) ) {
+          std::istringstream bounds( range );
+          size_t             first = 0;
+          size_t             last  = 0;
+          char               dash  = 0;
+
+          if ( !( bounds >> first ) ) {
+            continue;
+          }
+
+          last = ( bounds >> dash >> last ) ? last : first;
+
+          for ( auto cpu = first; ( cpu <= last ) && ( cpu < cpus ); ++cpu ) {
+            node[ cpu ] = nodes;
+          }
+        }
+      }
+
+      nodes = std::max( nodes, ( size_t ) 1 );
+      return node;
+    }
+  } // namespace
+
+  ShardedPool::ShardedPool( const std::string &uri, const ShardOptions &options ) {
+    size_t cpus    = std::max( std::thread::hardware_concurrency( ), 1u );
+    size_t units   = cpus;
+    auto   maxSize = std::max( options.pool.maxSize, ( size_t ) 1 );
+
+    cpuShard.resize( cpus );
+
+    if ( options.sharding == ShardOptions::PER_NODE ) {
+      cpuShard = cpuNodes( cpus, units );
+    } else {
+      for ( size_t cpu = 0; cpu < cpus; ++cpu ) {
+        cpuShard[ cpu ] = cpu;
+      }
+    }
+
+    /* Every shard gets at least one connection */
+    auto count = std::min( options.shards ? options.shards : units, maxSize );
+
+    for ( auto &&shard : cpuShard ) {
+      shard %= count;
+    }
+
+    for ( size_t index = 0; index < count; ++index ) {
+      auto                     share = options.pool;
+      std::unique_ptr< Shard > shard( new Shard );
+
+      share.maxSize  = maxSize / count + ( index < maxSize % count ? 1 : 0 );
+      share.minIdle  = options.pool.minIdle / count + ( index < options.pool.minIdle % count ? 1 : 0 );
+      share.reserved = std::min( options.pool.reserved, share.maxSize - 1 );
+
+      shard->pool.reset( new Pool( uri, share ) );
+      shards.push_back( std::move( shard ) );
+    }
+  }
+
+  size_t ShardedPool::localShard( ) const {
+    auto cpu = sched_getcpu( );
+
+    return cpu < 0 ? 0 : cpuShard[ static_cast< size_t >( cpu ) % cpuShard.size( ) ];
+  }
+
+  Connection ShardedPool::getConnection( steady_clock_t::time_point deadline,
+                                         PoolOptions::Priority      priority,
+                                         const char *               site ) {
+    auto       home = localShard( );
+    Connection connection( nullptr );
+
+    for ( size_t step = 0; step < shards.size( ); ++step ) {
+      auto &shard = *shards[ ( home + step ) % shards.size( ) ];
+
+      try {
+        if ( !shard.pool->tryGetConnection( connection, priority, site ) ) {
+          continue;
+        }
+      } catch ( DBException & ) {
+        continue; // Unable to open a connection there; the other shards may have one
+      }
+
+      if ( step ) {
+        shard.lent.fetch_add( 1, std::memory_order_relaxed );
+        shards[ home ]->stolen.fetch_add( 1, std::memory_order_relaxed );
+      }
+
+      return connection;
+    }
+
+    return shards[ home ]->pool->getConnection( deadline, priority, site );
+  }
+} // namespace dbcpp
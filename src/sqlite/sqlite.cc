@@ -124,9 +124,14 @@ namespace dbcpp {
         void commit( ) override {}
         void rollback( ) override {}
         void begin( ) {}
-        bool disconnect( ) override { return false; }
+        bool disconnect( ) override {
+          statementCache( ).clear( );
+          return false;
+        }
         bool reconnect( ) override { return true; }
 
+        bool alive( ) override { return cxn && cxn->handle; }
+
         bool test( ) override {
           try {
             Statement statement = createStatement( "SELECT 1" );
@@ -181,10 +186,50 @@ namespace dbcpp {
         static const int SQLite_BlobType   = 2;
         static const int SQLite_NullType   = 3;
         static const int SQLite_StringType = 4;
-        using COLUMN  = boost::variant< int64_t, double, std::vector< uint8_t >, decltype( nullptr ), std::string >;
+        /** Column or parameter value; borrowed values are only ever parameters */
+        using COLUMN  = boost::variant< int64_t,
+                                        double,
+                                        std::vector< uint8_t >,
+                                        decltype( nullptr ),
+                                        std::string,
+                                        StringRef,
+                                        ByteRef >;
         using COLUMNS = std::vector< COLUMN >;
         using ROWS    = std::vector< COLUMNS >;
 
+        /** Binds a parameter value, without copying; the value must outlive the binding */
+        struct Binder : public boost::static_visitor< int > {
+          sqlite3_stmt *handle;
+          int           index;
+
+          Binder( sqlite3_stmt *_handle, size_t parameter )
+            : handle( _handle )
+            , index( static_cast< int >( parameter ) + 1 ) {}
+
+          int operator( )( int64_t value ) const { return sqlite3_bind_int64( handle, index, value ); }
+          int operator( )( double value ) const { return sqlite3_bind_double( handle, index, value ); }
+          int operator( )( decltype( nullptr ) ) const { return sqlite3_bind_null( handle, index ); }
+          int operator( )( std::vector< uint8_t > &value ) const {
+            return sqlite3_bind_blob64( handle, index, value.data( ), value.size( ), SQLITE_STATIC );
+          }
+          int operator( )( std::string &value ) const {
+            return sqlite3_bind_text64( handle, index, value.c_str( ), value.length( ), SQLITE_STATIC, SQLITE_UTF8 );
+          }
+          int operator( )( ByteRef value ) const {
+            return sqlite3_bind_blob64( handle, index, value.data, value.size, SQLITE_STATIC );
+          }
+          int operator( )( StringRef value ) const {
+            return sqlite3_bind_text64( handle, index, value.data, value.size, SQLITE_STATIC, SQLITE_UTF8 );
+          }
+        };
+
+        /** Host variable bound to a parameter */
+        struct Host {
+          HostType    type;
+          const void *address; /**< nullptr if not bound */
+          const bool *isNull;
+        };
+
         std::shared_ptr< SQLiteConnection > connection;
         std::vector< std::string >          columnNames;
         std::vector< int >                  columnTypes;
@@ -193,6 +238,9 @@ namespace dbcpp {
         ROWS::size_type                     affected;
         COLUMNS::size_type                  fields;
         ROWS                                results;
+        COLUMNS                             parameters; /**< Bound parameter values */
+        ROWS                                batch;      /**< Parameter sets added to the batch */
+        std::vector< Host >                 hosts;      /**< Bound host variables, by parameter */
 
         SQLiteStatement( std::shared_ptr< SQLiteConnection > _connection, const std::string &_query )
           : connection( std::move( _connection ) )
@@ -221,15 +269,22 @@ namespace dbcpp {
 
           handle.reset( tmp, sqlite3_finalize );
           fields = sqlite3_column_count( handle.get( ) );
+          parameters.resize( sqlite3_bind_parameter_count( handle.get( ) ), nullptr );
 
           LOG( logger, trace, "Query {} resulted in {} fields", query, fields );
         }
 
-        void reset( ) {
+        void reset( ) override {
           LOG( logger, debug, "Resetting bound parameters for query" );
 
           sqlite3_reset( handle.get( ) );
           sqlite3_clear_bindings( handle.get( ) );
+
+          parameters.assign( parameters.size( ), nullptr );
+          columnNames.clear( );
+          columnTypes.clear( );
+          results.clear( );
+          affected = 0;
         }
 
         bool setParam( size_t parameter, dbcpp::interface::safebool value ) override {
@@ -245,7 +300,7 @@ namespace dbcpp {
         bool setParam( size_t parameter, int64_t value ) override {
           LOG( logger, trace, "Set parameter #{} to int", parameter + 1 );
 
-          return sqlite3_bind_int64( handle.get( ), ( int ) parameter + 1, value ) == SQLITE_OK;
+          return bind( parameter, COLUMN{ value } );
         }
 
         bool setParam( size_t parameter, float value ) override { return setParam( parameter, ( double ) value ); }
@@ -254,25 +309,31 @@ namespace dbcpp {
         }
         bool setParam( size_t parameter, double value ) override {
           LOG( logger, trace, "Set parameter #{} to double", parameter + 1 );
-          return sqlite3_bind_double( handle.get( ), ( int ) parameter + 1, value ) == SQLITE_OK;
+          return bind( parameter, COLUMN{ value } );
         }
 
         bool setParam( size_t parameter, std::string value ) override {
           LOG( logger, trace, "Set parameter #{} to string", parameter + 1 );
 
-          return sqlite3_bind_text64( handle.get( ), //
-                                      parameter + 1,
-                                      value.c_str( ),
-                                      value.length( ),
-                                      SQLITE_TRANSIENT,
-                                      SQLITE_UTF8 ) == SQLITE_OK;
+          return bind( parameter, COLUMN{ std::move( value ) } );
         }
 
         bool setParam( size_t parameter, std::vector< uint8_t > value ) override {
           LOG( logger, trace, "Set parameter #{} to bytea", parameter + 1 );
 
-          return sqlite3_bind_blob64( handle.get( ), parameter + 1, &value[ 0 ], value.size( ), SQLITE_TRANSIENT ) ==
-                 SQLITE_OK;
+          return bind( parameter, COLUMN{ std::move( value ) } );
+        }
+
+        bool setParam( size_t parameter, StringRef value ) override {
+          LOG( logger, trace, "Set parameter #{} to borrowed string", parameter + 1 );
+
+          return bind( parameter, COLUMN{ value } );
+        }
+
+        bool setParam( size_t parameter, ByteRef value ) override {
+          LOG( logger, trace, "Set parameter #{} to borrowed bytea", parameter + 1 );
+
+          return bind( parameter, COLUMN{ value } );
         }
 
         bool setParam( size_t parameter, DBTime value ) override {
@@ -289,12 +350,131 @@ namespace dbcpp {
 
         bool setParamNull( size_t parameter, FieldType type ) override {
           LOG( logger, trace, "Set parameter #{} to null", parameter + 1 );
-          return sqlite3_bind_null( handle.get( ), parameter + 1 );
+          return bind( parameter, COLUMN{ nullptr } );
+        }
+
+        /**
+         * @brief Keep a parameter value, binding the kept value
+         * @param parameter parameter index (0 start)
+         * @param value parameter value
+         * @return true on success, false on failure
+         */
+        bool bind( size_t parameter, COLUMN value ) {
+          if ( parameter >= parameters.size( ) ) {
+            return false;
+          }
+
+          parameters[ parameter ] = std::move( value );
+
+          return boost::apply_visitor( Binder( handle.get( ), parameter ), parameters[ parameter ] ) == SQLITE_OK;
+        }
+
+        bool bindParam( size_t parameter, HostType type, const void *address, const bool *isNull ) override {
+          if ( parameter >= parameters.size( ) ) {
+            return false;
+          }
+
+          LOG( logger, trace, "Bind parameter #{} to a host variable", parameter + 1 );
+
+          hosts.resize( parameters.size( ), Host{ HOST_BOOL, nullptr, nullptr } );
+          hosts[ parameter ] = Host{ type, address, isNull };
+          return true;
+        }
+
+        void unbindParams( ) override { hosts.clear( ); }
+
+        /**
+         * @brief Get a host variable's current value, borrowing strings and blobs
+         * @param host bound host variable
+         * @return parameter value
+         */
+        static COLUMN hostValue( const Host &host ) {
+#define HOST( _type ) ( *static_cast< const _type * >( host.address ) )
+          if ( host.isNull && *host.isNull ) {
+            return COLUMN{ nullptr };
+          }
+
+          switch ( host.type ) {
+            case HOST_BOOL:
+              return COLUMN{ static_cast< int64_t >( HOST( bool ) ) };
+            case HOST_INT8:
+              return COLUMN{ static_cast< int64_t >( HOST( int8_t ) ) };
+            case HOST_UINT8:
+              return COLUMN{ static_cast< int64_t >( HOST( uint8_t ) ) };
+            case HOST_INT16:
+              return COLUMN{ static_cast< int64_t >( HOST( int16_t ) ) };
+            case HOST_UINT16:
+              return COLUMN{ static_cast< int64_t >( HOST( uint16_t ) ) };
+            case HOST_INT32:
+              return COLUMN{ static_cast< int64_t >( HOST( int32_t ) ) };
+            case HOST_UINT32:
+              return COLUMN{ static_cast< int64_t >( HOST( uint32_t ) ) };
+            case HOST_INT64:
+              return COLUMN{ HOST( int64_t ) };
+            case HOST_UINT64:
+              return COLUMN{ static_cast< int64_t >( HOST( uint64_t ) ) };
+            case HOST_FLOAT:
+              return COLUMN{ static_cast< double >( HOST( float ) ) };
+            case HOST_DOUBLE:
+              return COLUMN{ HOST( double ) };
+            case HOST_STRING:
+              return COLUMN{ StringRef( HOST( std::string ) ) };
+            case HOST_VARBYTE:
+              return COLUMN{ ByteRef( HOST( VarByte ) ) };
+            case HOST_TIME: {
+              time_t _time = DBClock::to_time_t( HOST( DBTime ) );
+
+              if ( _time ) {
+                struct tm _tm          = { 0 };
+                char      block[ 128 ] = "";
+                gmtime_r( &_time, &_tm );
+                ::strftime( block, sizeof( block ), "%F %T", &_tm );
+                return COLUMN{ std::string( block ) };
+              }
+              break;
+            }
+          }
+#undef HOST
+
+          return COLUMN{ nullptr };
+        }
+
+        /**
+         * @brief Rewind the statement, binding the bound host variables' current values
+         * @return true on success, false on failure
+         */
+        bool bindHosts( ) {
+          sqlite3_reset( handle.get( ) );
+
+          columnNames.clear( );
+          columnTypes.clear( );
+          results.clear( );
+
+          for ( size_t parameter = 0; parameter < hosts.size( ); ++parameter ) {
+            if ( !hosts[ parameter ].address ) {
+              continue;
+            }
+
+            /* Not kept: strings and blobs are bound from the host variables themselves */
+            auto value = hostValue( hosts[ parameter ] );
+
+            if ( boost::apply_visitor( Binder( handle.get( ), parameter ), value ) != SQLITE_OK ) {
+              return false;
+            }
+          }
+
+          return true;
         }
 
         void execute( ) override {
           std::lock_guard< std::mutex > guard( connection->cxn->mutex );
 
+          if ( !hosts.empty( ) && !bindHosts( ) ) {
+            auto code = sqlite3_extended_errcode( connection->cxn->handle.get( ) );
+
+            throw DBException( std::string( "Unable to bind host variables: " ) + sqlite3_errstr( code ) );
+          }
+
           columnTypes.resize( fields, SQLITE_NULL );
 
           LOG( logger, trace, "Executing query: {}", query );
@@ -381,6 +561,98 @@ namespace dbcpp {
           return affected;
         }
 
+        void addBatch( ) override {
+          auto row = parameters;
+
+          /* The host variables change before the next set is added: keep their current values */
+          for ( size_t parameter = 0; parameter < hosts.size( ); ++parameter ) {
+            if ( !hosts[ parameter ].address ) {
+              continue;
+            }
+
+            row[ parameter ] = hostValue( hosts[ parameter ] );
+
+            if ( auto text = boost::get< StringRef >( &row[ parameter ] ) ) {
+              row[ parameter ] = std::string( text->data, text->size );
+            } else if ( auto bytes = boost::get< ByteRef >( &row[ parameter ] ) ) {
+              row[ parameter ] = VarByte( bytes->data, bytes->data + bytes->size );
+            }
+          }
+
+          batch.push_back( std::move( row ) );
+        }
+
+        /**
+         * @brief Step the statement once per parameter set, inside one transaction unless
+         *        one is already open
+         * @return number of affected rows, per parameter set
+         */
+        std::vector< int > executeBatch( ) override {
+          std::vector< int > counts;
+          ROWS               rows;
+
+          rows.swap( batch );
+
+          if ( rows.empty( ) ) {
+            return counts;
+          }
+
+          std::lock_guard< std::mutex > guard( connection->cxn->mutex );
+
+          auto db    = connection->cxn->handle.get( );
+          auto owned = sqlite3_get_autocommit( db ) != 0;
+
+          auto fail = [ & ]( ) {
+            auto code = sqlite3_extended_errcode( db );
+            auto msg  = std::string( sqlite3_errstr( code ) ) + ": " + sqlite3_errmsg( db );
+
+            sqlite3_reset( handle.get( ) );
+            sqlite3_clear_bindings( handle.get( ) );
+
+            if ( owned ) {
+              sqlite3_exec( db, "ROLLBACK", nullptr, nullptr, nullptr );
+            }
+
+            throw DBException( msg );
+          };
+
+          LOG( logger, trace, "Executing a batch of {} parameter set(s): {}", rows.size( ), query );
+
+          if ( owned && ( sqlite3_exec( db, "BEGIN", nullptr, nullptr, nullptr ) != SQLITE_OK ) ) {
+            owned = false;
+            fail( );
+          }
+
+          for ( auto &&row : rows ) {
+            int status = SQLITE_OK;
+
+            sqlite3_reset( handle.get( ) );
+
+            for ( size_t parameter = 0; parameter < row.size( ); ++parameter ) {
+              boost::apply_visitor( Binder( handle.get( ), parameter ), row[ parameter ] );
+            }
+
+            while ( ( status = sqlite3_step( handle.get( ) ) ) == SQLITE_ROW ) {
+            }
+
+            if ( status != SQLITE_DONE ) {
+              fail( );
+            }
+
+            counts.push_back( sqlite3_changes( db ) );
+          }
+
+          /* The bindings refer to the batch */
+          sqlite3_reset( handle.get( ) );
+          sqlite3_clear_bindings( handle.get( ) );
+
+          if ( owned && ( sqlite3_exec( db, "COMMIT", nullptr, nullptr, nullptr ) != SQLITE_OK ) ) {
+            fail( );
+          }
+
+          return counts;
+        }
+
         DBResultSet getResults( ) override { return std::make_shared< SQLiteResultSet >( shared_from_this( ) ); }
       };
 
@@ -414,7 +686,7 @@ namespace dbcpp {
         int32_t  getI32( ) const { return getI64( ); }
         uint64_t getU64( ) const { return getI64( ); }
         int64_t  getI64( ) const {
-          auto    col   = getCol( );
+          auto &  col   = getCol( );
           int64_t value = 0;
 
           switch ( col.which( ) ) {
@@ -439,7 +711,7 @@ namespace dbcpp {
         }
 
         double getDouble( ) const {
-          auto   col   = getCol( );
+          auto & col   = getCol( );
           double value = nan( "" );
 
           switch ( col.which( ) ) {
@@ -470,7 +742,7 @@ namespace dbcpp {
         float       getFloat( ) const { return getDouble( ); }
 
         std::string getString( ) const {
-          auto col = getCol( );
+          auto &col = getCol( );
 
           switch ( col.which( ) ) {
             case SQLiteStatement::SQLite_IntType: {
@@ -19,6 +19,16 @@
 #define PSQLURI "psql://" POSTGRESQL_USERNAME ":" POSTGRESQL_PASSWORD "@" POSTGRESQL_HOSTNAME "/" POSTGRESQL_DATABASE
 #define SQLITEURI "sqlite://memory"
 
+#define CHECK( expr )                                                                                                  \
+  do {                                                                                                                 \
+    if ( !( expr ) ) {                                                                                                 \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #expr "\n";                                       \
+      ++failures;                                                                                                      \
+    }                                                                                                                  \
+  } while ( 0 )
+
+static int failures = 0;
+
 static void test( std::stringstream &page, dbcpp::Connection &connection, const std::string &mainQuery ) {
   auto statement = connection.createStatement( mainQuery );
   auto now       = std::chrono::high_resolution_clock::now( );
@@ -184,6 +194,297 @@ std::string executeDBTest( std::string uri, const std::string &mainQuery ) {
   return page.str( );
 }
 
+/**
+ * @brief Commit positions are only captured once asked for, and never run ahead of the
+ *        server's own position
+ */
+static void testCommitPosition( const std::string &uri ) {
+  dbcpp::Pool pool( uri, 1 );
+  auto        connection = pool.getConnection( );
+
+  connection.commit( );
+  CHECK( connection.commitPosition( ) == 0 );
+
+  CHECK( connection.trackCommitPosition( ) );
+  connection.commit( );
+
+  auto position = connection.commitPosition( );
+
+  CHECK( position > 0 );
+  CHECK( connection.replayPosition( ) >= position );
+
+  connection.trackCommitPosition( false );
+  connection.commit( );
+  CHECK( connection.commitPosition( ) == position );
+}
+
+/**
+ * @brief Hot statements are prepared in one pipeline, those after a failing one included, and
+ *        leave the connection usable
+ */
+static void testPreparePipeline( const std::string &uri ) {
+  dbcpp::PoolOptions options;
+
+  options.hotStatements = { "SELECT 1", "SELECT FROM nowhere", "SELECT ?::integer + 1" };
+
+  dbcpp::Pool pool( uri, options );
+  auto        connection = pool.getConnection( );
+
+  CHECK( connection.statementCache( ).contains( "SELECT 1" ) );
+  CHECK( connection.statementCache( ).contains( "SELECT ?::integer + 1" ) );
+
+  auto statement = connection.createStatement( "SELECT ?::integer + 1" );
+
+  statement << 41;
+
+  auto result = statement.executeQuery( );
+
+  CHECK( result.next( ) && ( result.get< int >( 0 ) == 42 ) );
+}
+
+/**
+ * @brief Query a server setting on a connection
+ */
+static std::string setting( dbcpp::Connection &connection, const std::string &name ) {
+  auto statement = connection.createStatement( "SELECT current_setting( ? )" );
+
+  statement << name;
+
+  auto result = statement.executeQuery( );
+
+  return result.next( ) ? result.get< std::string >( 0 ) : std::string{ };
+}
+
+/**
+ * @brief Session parameters are sent with the next statement, kept by a commit and reverted by
+ *        a rollback to their committed values
+ */
+static void testSessionParams( const std::string &uri ) {
+  dbcpp::Pool pool( uri, 1 );
+  auto        connection = pool.getConnection( );
+
+  CHECK( connection.setSessionParam( "dbcpp.test", "one" ) );
+  CHECK( connection.sessionParam( "dbcpp.test" ) == "one" );
+  CHECK( setting( connection, "dbcpp.test" ) == "one" );
+  connection.commit( );
+
+  connection.setSessionParam( "dbcpp.test", "two" );
+  CHECK( setting( connection, "dbcpp.test" ) == "two" );
+  connection.rollback( );
+
+  CHECK( connection.sessionParam( "dbcpp.test" ) == "one" );
+  CHECK( setting( connection, "dbcpp.test" ) == "one" );
+
+  /* Not yet sent, so a commit leaves it to the next statement, in a transaction a rollback undoes */
+  connection.setSessionParam( "dbcpp.test", "three" );
+  connection.commit( );
+
+  CHECK( setting( connection, "dbcpp.test" ) == "three" );
+  connection.rollback( );
+
+  CHECK( connection.sessionParam( "dbcpp.test" ) == "one" );
+  CHECK( setting( connection, "dbcpp.test" ) == "one" );
+
+  /* Likewise left to the next statement by a rollback */
+  connection.setSessionParam( "dbcpp.test", "four" );
+  connection.rollback( );
+
+  CHECK( connection.sessionParam( "dbcpp.test" ) == "four" );
+  CHECK( setting( connection, "dbcpp.test" ) == "four" );
+}
+
+/**
+ * @brief Query a count on a connection
+ */
+static int64_t count( dbcpp::Connection &connection, const std::string &query ) {
+  auto result = connection.createStatement( query ).executeQuery( );
+
+  return result.next( ) ? result.get< int64_t >( 0 ) : -1;
+}
+
+/**
+ * @brief Batches run in one pipeline, applying every parameter set or none, with a single
+ *        commit in auto commit mode; sets binding a parameter with different types are rejected
+ */
+static void testBatch( const std::string &uri ) {
+  dbcpp::Pool pool( uri, 2 );
+  auto        connection = pool.getConnection( );
+  auto        observer   = pool.getConnection( );
+  std::string table      = "batch_" + std::to_string( ( uint32_t ) PROCESS_ID( ) );
+  std::string rows       = "SELECT COUNT( * ) FROM " + table;
+
+  connection.createStatement( "CREATE TABLE " + table + " ( id INTEGER PRIMARY KEY, v VARCHAR( 10 ) )" ).execute( );
+  connection.commit( );
+  connection.setAutoCommit( true );
+
+  auto insert = connection.createStatement( "INSERT INTO " + table + " ( id, v ) VALUES ( ?, ? )" );
+
+  for ( int32_t id = 1; id <= 3; ++id ) {
+    insert << id << std::to_string( id );
+    insert.addBatch( );
+  }
+
+  insert << 4 << ( std::string * ) nullptr;
+  insert.addBatch( );
+
+  CHECK( insert.executeBatch( ) == std::vector< int >( 4, 1 ) );
+  CHECK( count( observer, rows ) == 4 );
+  CHECK( count( observer, "SELECT COUNT( DISTINCT xmin::text ) FROM " + table ) == 1 );
+  observer.commit( );
+
+  /* A failed parameter set rolls back the whole batch */
+  insert << 5 << "5";
+  insert.addBatch( );
+  insert << 1 << "duplicate";
+  insert.addBatch( );
+
+  try {
+    insert.executeBatch( );
+    CHECK( false );
+  } catch ( dbcpp::DBException & ) {
+  }
+
+  CHECK( count( connection, rows ) == 4 );
+
+  /* Prepared once for the whole batch, so its types must agree */
+  insert << 6 << "6";
+  insert.addBatch( );
+  insert << ( int64_t ) 7 << "7";
+  insert.addBatch( );
+
+  try {
+    insert.executeBatch( );
+    CHECK( false );
+  } catch ( dbcpp::DBException & ) {
+  }
+
+  CHECK( count( connection, rows ) == 4 );
+
+  connection.createStatement( "DROP TABLE " + table ).execute( );
+  connection.commit( );
+}
+
+/**
+ * @brief Host variables are encoded by their bound types at each execution, and are not
+ *        replaced by setParam( )
+ */
+static void testHostVariables( const std::string &uri ) {
+  dbcpp::Pool pool( uri, 1 );
+  auto        connection = pool.getConnection( );
+  int64_t     id         = 1;
+  std::string name       = "one";
+  double      ratio      = 0.5;
+  bool        flag       = true;
+  bool        noName     = false;
+  auto        statement  = connection.createStatement( "SELECT ?, ?::varchar, ?, ?" );
+
+  CHECK( statement.bindParam( 0, &id ) );
+  CHECK( statement.bindParam( 1, &name, &noName ) );
+  CHECK( statement.bindParam( 2, &ratio ) );
+  CHECK( statement.bindParam( 3, &flag ) );
+  CHECK( !statement.setParam( 0, ( int64_t ) 5 ) );
+
+  {
+    auto result = statement.executeQuery( );
+
+    CHECK( result.next( ) );
+    CHECK( result.get< int64_t >( 0 ) == 1 );
+    CHECK( result.get< std::string >( 1 ) == "one" );
+    CHECK( result.get< double >( 2 ) == 0.5 );
+    CHECK( result.get< bool >( 3 ) );
+  }
+
+  id     = -( int64_t( 1 ) << 40 );
+  noName = true;
+  ratio  = -1.25;
+  flag   = false;
+
+  {
+    auto result = statement.executeQuery( );
+
+    CHECK( result.next( ) );
+    CHECK( result.get< int64_t >( 0 ) == id );
+    CHECK( result.isNull( 1 ) );
+    CHECK( result.get< double >( 2 ) == -1.25 );
+    CHECK( !result.get< bool >( 3 ) );
+  }
+}
+
+/**
+ * @brief Bound columns are decoded straight from the binary results, by column type, and
+ *        through their field otherwise
+ */
+static void testColumnBinding( const std::string &uri ) {
+  dbcpp::Pool    pool( uri, 1 );
+  auto           connection = pool.getConnection( );
+  int16_t        small      = 0;
+  int64_t        widened    = 0;
+  int64_t        big        = 0;
+  float          quarter    = 0;
+  double         exact      = 0;
+  bool           even       = false;
+  std::string    text;
+  std::string    number;
+  dbcpp::VarByte bytes;
+  dbcpp::DBTime  stamp;
+  int32_t        nullable   = 0;
+  bool           isNull     = false;
+  auto           statement  = connection.createStatement( "SELECT n::smallint, n, n::bigint * 1099511627776"
+                                                          ", ( n / 4.0 )::real, ( n / 4.0 )::float8, n % 2 = 0"
+                                                          ", 'row ' || n, decode( lpad( n::text, 2, '0' ), 'hex' )"
+                                                          ", TIMESTAMP '2000-01-01' + n * INTERVAL '1 second'"
+                                                          ", NULLIF( n, 2 ) FROM generate_series( 1, 3 ) AS n" );
+  auto           result     = statement.executeQuery( );
+
+  CHECK( result.bindColumn( 0, &small ) );
+  CHECK( result.bindColumn( 1, &widened ) );
+  CHECK( result.bindColumn( 2, &big ) );
+  CHECK( result.bindColumn( 3, &quarter ) );
+  CHECK( result.bindColumn( 4, &exact ) );
+  CHECK( result.bindColumn( 5, &even ) );
+  CHECK( result.bindColumn( 6, &text ) );
+  CHECK( result.bindColumn( 7, &bytes ) );
+  CHECK( result.bindColumn( 8, &stamp ) );
+  CHECK( result.bindColumn( 9, &nullable, &isNull ) );
+
+  for ( int32_t n = 1; n <= 3; ++n ) {
+    CHECK( result.next( ) );
+    CHECK( ( small == n ) && ( widened == n ) && ( big == ( int64_t( n ) << 40 ) ) );
+    CHECK( ( quarter == n / 4.0f ) && ( exact == n / 4.0 ) && ( even == ( n % 2 == 0 ) ) );
+    CHECK( text == "row " + std::to_string( n ) );
+    CHECK( bytes == dbcpp::VarByte( 1, static_cast< uint8_t >( n ) ) );
+    CHECK( stamp == dbcpp::DBTime( std::chrono::seconds( 946684800 + n ) ) );
+    CHECK( ( isNull == ( n == 2 ) ) && ( nullable == ( n == 3 ? 3 : 1 ) ) );
+  }
+
+  CHECK( !result.next( ) );
+
+  /* Columns without a direct decoding go through their field */
+  auto again = statement.executeQuery( );
+
+  CHECK( again.bindColumn( 1, &number ) );
+  CHECK( again.next( ) && ( number == "1" ) );
+}
+
+/**
+ * @brief Typed queries run against the server with their arguments encoded by type
+ */
+static void testTypedQuery( const std::string &uri ) {
+  static constexpr dbcpp::TypedQuery< int32_t, std::string > query{ " SELECT ? + 1, '?' || ? " };
+
+  dbcpp::Pool pool( uri, 1 );
+  auto        connection = pool.getConnection( );
+  auto        statement  = connection.createStatement( query );
+
+  for ( int32_t value = 1; value <= 2; ++value ) {
+    auto result = statement.executeQuery( value, std::to_string( value ) );
+
+    CHECK( result.next( ) );
+    CHECK( result.get< int32_t >( 0 ) == value + 1 );
+    CHECK( result.get< std::string >( 1 ) == "?" + std::to_string( value ) );
+  }
+}
+
 void log_init( void ) {
   auto        sink    = std::make_shared< spdlog::sinks::stdout_color_sink_mt >( );
   std::string names[] = { "dbcpp::psql", "dbcpp::sqlite", "dbcpp::Pool", "dbcpp::Driver" };
@@ -247,5 +548,13 @@ int main( int argc, char *argv[] ) {
     std::cout << "\n";
   }
 
-  return 0;
+  testCommitPosition( PSQLURI );
+  testPreparePipeline( PSQLURI );
+  testSessionParams( PSQLURI );
+  testBatch( PSQLURI );
+  testHostVariables( PSQLURI );
+  testColumnBinding( PSQLURI );
+  testTypedQuery( PSQLURI );
+
+  return failures ? 1 : 0;
 }
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dbc++/dbcpp.hh"
+
+#define SQLITEURI "sqlite://memory"
+
+/**
+ * @brief Run the operation on the number of threads for the duration
+ * @param threads thread count
+ * @param duration run time
+ * @param operation single checkout/check-in cycle
+ * @return cycles per second, across all threads
+ */
+static double run( size_t threads, std::chrono::milliseconds duration, std::function< void( ) > operation ) {
+  std::atomic< bool >        running( true );
+  std::atomic< uint64_t >    total( 0 );
+  std::vector< std::thread > workers;
+
+  for ( size_t num = 0; num < threads; ++num ) {
+    workers.emplace_back( [ &running, &total, &operation ]( ) {
+      uint64_t cycles = 0;
+
+      while ( running.load( std::memory_order_relaxed ) ) {
+        operation( );
+        ++cycles;
+      }
+
+      total += cycles;
+    } );
+  }
+
+  std::this_thread::sleep_for( duration );
+  running = false;
+
+  for ( auto &&worker : workers ) {
+    worker.join( );
+  }
+
+  return total * 1000.0 / duration.count( );
+}
+
+int main( int argc, char *argv[] ) {
+  auto   duration   = std::chrono::milliseconds( argc > 1 ? std::stoul( argv[ 1 ] ) : 500 );
+  size_t maxThreads = std::max( 2 * std::thread::hardware_concurrency( ), 32u );
+  size_t poolSize   = std::max( std::thread::hardware_concurrency( ), 1u );
+
+  dbcpp::ShardOptions sharding;
+
+  sharding.pool.minIdle = poolSize;
+  sharding.pool.maxSize = poolSize;
+
+  dbcpp::internal::FreeList freeList( poolSize );
+  dbcpp::Pool               pool( SQLITEURI, poolSize );
+  dbcpp::ShardedPool        sharded( SQLITEURI, sharding );
+
+  for ( size_t index = 0; index < poolSize; ++index ) {
+    freeList.push( index );
+  }
+
+  /* Rates only; whether sharding pays depends on the host's CPUs, and with one shard the columns measure the same */
+  std::cout << "shards: " << sharded.size( ) << "\n";
+  std::cout << std::setw( 8 ) << "threads" << std::setw( 20 ) << "freelist ops/s" << std::setw( 20 )
+            << "checkouts/s" << std::setw( 20 ) << "sharded/s"
+            << "\n";
+
+  for ( size_t threads = 1; threads <= maxThreads; threads *= 2 ) {
+    auto listRate = run( threads, duration, [ &freeList ]( ) {
+      size_t index = 0;
+
+      if ( freeList.pop( index ) ) {
+        freeList.push( index );
+      }
+    } );
+    auto poolRate  = run( threads, duration, [ &pool ]( ) { pool.getConnection( ); } );
+    auto shardRate = run( threads, duration, [ &sharded ]( ) { sharded.getConnection( ); } );
+
+    std::cout << std::setw( 8 ) << threads << std::fixed << std::setprecision( 0 ) << std::setw( 20 ) << listRate
+              << std::setw( 20 ) << poolRate << std::setw( 20 ) << shardRate << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,1055 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "dbc++/dbcpp.hh"
+
+#define SQLITEURI "sqlite://memory"
+
+#define CHECK( expr )                                                                                                  \
+  do {                                                                                                                 \
+    if ( !( expr ) ) {                                                                                                 \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #expr "\n";                                       \
+      ++failures;                                                                                                      \
+    }                                                                                                                  \
+  } while ( 0 )
+
+static int failures = 0;
+
+void log_init( void ) {
+  auto        sink    = std::make_shared< spdlog::sinks::stdout_color_sink_mt >( );
+  std::string names[] = { "dbcpp::sqlite", "dbcpp::Pool", "dbcpp::Driver", "dbcpp::ClusterPool" };
+  for ( auto &&name : names ) {
+    dbcpp::create_logger( name, { sink } )->set_level( spdlog::level::warn );
+  }
+}
+
+/**
+ * @brief A checkout against an exhausted pool fails once its timeout expires
+ */
+static void testCheckoutTimeout( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  auto        held     = pool.getConnection( );
+  auto        start    = std::chrono::steady_clock::now( );
+  bool        timedOut = false;
+
+  try {
+    pool.getConnection( std::chrono::milliseconds( 50 ) );
+  } catch ( dbcpp::DBException & ) {
+    timedOut = true;
+  }
+
+  CHECK( timedOut );
+  CHECK( std::chrono::steady_clock::now( ) - start >= std::chrono::milliseconds( 50 ) );
+}
+
+/**
+ * @brief A parked checkout is handed the connection when it is released
+ */
+static void testCheckoutWakeup( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  bool        acquired = false;
+  std::thread waiter;
+
+  {
+    auto held = pool.getConnection( );
+
+    waiter = std::thread( [ &pool, &acquired ]( ) {
+      try {
+        pool.getConnection( std::chrono::seconds( 5 ) );
+        acquired = true;
+      } catch ( dbcpp::DBException & ) {
+      }
+    } );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+  }
+
+  waiter.join( );
+  CHECK( acquired );
+}
+
+/**
+ * @brief Copies of a leased connection return it to the pool exactly once
+ */
+static void testLeaseCopies( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  bool        timedOut = false;
+
+  {
+    auto held = pool.getConnection( );
+    auto copy = held;
+  }
+
+  auto held = pool.getConnection( std::chrono::milliseconds( 0 ) );
+
+  try {
+    pool.getConnection( std::chrono::milliseconds( 10 ) );
+  } catch ( dbcpp::DBException & ) {
+    timedOut = true;
+  }
+
+  CHECK( timedOut );
+}
+
+/**
+ * @brief The pool grows on demand up to its maximum and reaps idle connections back to its minimum
+ */
+static void testElasticSizing( ) {
+  dbcpp::PoolOptions options;
+  bool               timedOut = false;
+
+  options.minIdle     = 1;
+  options.maxSize     = 3;
+  options.checkPeriod = std::chrono::milliseconds( 20 );
+  options.idleTimeout = std::chrono::milliseconds( 20 );
+
+  dbcpp::Pool pool( SQLITEURI, options );
+
+  CHECK( pool.size( ) == 1 );
+
+  {
+    auto first  = pool.getConnection( );
+    auto second = pool.getConnection( );
+    auto third  = pool.getConnection( );
+
+    CHECK( pool.size( ) == 3 );
+
+    try {
+      pool.getConnection( std::chrono::milliseconds( 10 ) );
+    } catch ( dbcpp::DBException & ) {
+      timedOut = true;
+    }
+
+    CHECK( timedOut );
+  }
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+
+  CHECK( pool.size( ) == 1 );
+}
+
+/**
+ * @brief Idle checks test a bounded number of connections in place, leaving the rest open and available
+ */
+static void testIdleChecks( ) {
+  dbcpp::PoolOptions options;
+
+  options.minIdle     = 3;
+  options.maxSize     = 6;
+  options.idleTests   = 1;
+  options.checkPeriod = std::chrono::milliseconds( 1 );
+
+  dbcpp::Pool pool( SQLITEURI, options );
+
+  /* Checkouts alongside the checks always find the most recently used connection idle */
+  for ( int num = 0; num < 100; ++num ) {
+    pool.getConnection( std::chrono::milliseconds( 100 ) );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+  }
+
+  CHECK( pool.size( ) == 3 );
+  CHECK( pool.stats( ).opened == 3 );
+
+  auto connection = pool.getConnection( std::chrono::milliseconds( 100 ) );
+
+  CHECK( pool.idle( ) == 2 );
+}
+
+/**
+ * @brief Checkouts, waits and timeouts are reflected in the pool statistics
+ */
+static void testStats( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+
+  {
+    auto held = pool.getConnection( );
+
+    try {
+      pool.getConnection( std::chrono::milliseconds( 1 ) );
+    } catch ( dbcpp::DBException & ) {
+    }
+
+    auto stats = pool.stats( );
+
+    CHECK( stats.inUse == 1 );
+    CHECK( stats.idle == 0 );
+  }
+
+  auto stats = pool.stats( );
+
+  CHECK( stats.checkouts == 1 );
+  CHECK( stats.waits == 1 );
+  CHECK( stats.timeouts == 1 );
+  CHECK( stats.inUse == 0 );
+  CHECK( stats.waitTime.count == 1 );
+  CHECK( stats.leaseTime.count == 1 );
+  CHECK( dbcpp::Histogram::lowerBound( dbcpp::Histogram::bucket( 1000 ) ) <= 1000 );
+  CHECK( dbcpp::Histogram::lowerBound( dbcpp::Histogram::bucket( 1000 ) + 1 ) > 1000 );
+}
+
+/**
+ * @brief Statements prepared on one lease are reused, reset, on the next lease of the connection
+ */
+static void testStatementCache( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+
+  for ( int32_t value = 1; value <= 3; ++value ) {
+    auto cxn       = pool.getConnection( );
+    auto statement = cxn.createStatement( "SELECT ?" );
+
+    statement << value;
+
+    auto result = statement.executeQuery( );
+
+    CHECK( result.next( ) );
+    CHECK( result.get< int32_t >( 0 ) == value );
+    CHECK( !result.next( ) );
+  }
+
+  {
+    auto cxn   = pool.getConnection( );
+    auto held  = cxn.createStatement( "SELECT ?" );
+    auto other = cxn.createStatement( "SELECT ?" );
+
+    CHECK( cxn.statementCache( ).size( ) == 1 );
+  }
+
+  auto stats = pool.stats( );
+
+  CHECK( stats.statementHits == 3 );
+  CHECK( stats.statementMisses == 2 );
+
+  {
+    auto cxn = pool.getConnection( );
+
+    cxn.createStatement( "SELECT ?" );
+    cxn.disconnect( );
+
+    /* Cached statements reference their connection; a disconnect releases them */
+    CHECK( cxn.statementCache( ).size( ) == 0 );
+  }
+}
+
+/**
+ * @brief Consecutive connection failures open the breaker, rejecting checkouts until a probe
+ *        is admitted after the delay
+ */
+static void testCircuitBreaker( ) {
+  dbcpp::PoolOptions options;
+  int                failed   = 0;
+  int                rejected = 0;
+
+  options.minIdle      = 0;
+  options.maxSize      = 2;
+  options.breakerLimit = 2;
+  options.breakerDelay = std::chrono::milliseconds( 50 );
+
+  dbcpp::Pool pool( "sqlite:///nonexistent/directory/pool.db", options );
+
+  auto attempt = [ & ]( ) {
+    try {
+      pool.getConnection( std::chrono::milliseconds( 10 ) );
+    } catch ( dbcpp::PoolUnavailable & ) {
+      ++rejected;
+    } catch ( dbcpp::DBException & ) {
+      ++failed;
+    }
+  };
+
+  attempt( );
+  attempt( );
+  attempt( );
+
+  CHECK( failed == 2 );
+  CHECK( rejected == 1 );
+  CHECK( pool.stats( ).breaker == dbcpp::CircuitBreaker::OPEN );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 60 ) );
+
+  attempt( );
+  attempt( );
+
+  CHECK( failed == 3 );
+  CHECK( rejected == 2 );
+  CHECK( pool.stats( ).rejections == 2 );
+
+  /* Only the request admitted as the probe may give it up */
+  dbcpp::CircuitBreaker breaker( 1, std::chrono::milliseconds( 0 ) );
+  bool                  probe = false;
+  bool                  other = false;
+
+  breaker.failure( );
+
+  CHECK( breaker.admit( probe ) && probe );
+  CHECK( !breaker.admit( other ) );
+
+  breaker.abandon( other );
+
+  CHECK( !breaker.admit( other ) );
+
+  breaker.abandon( probe );
+
+  CHECK( breaker.admit( other ) && other );
+}
+
+/**
+ * @brief Checkouts beyond the waiter limit are rejected without waiting
+ */
+static void testWaiterLimit( ) {
+  dbcpp::PoolOptions options;
+  bool               rejected = false;
+
+  options.minIdle    = 1;
+  options.maxSize    = 1;
+  options.maxWaiters = 1;
+
+  dbcpp::Pool pool( SQLITEURI, options );
+  auto        held   = pool.getConnection( );
+  std::thread waiter = std::thread( [ &pool ]( ) {
+    try {
+      pool.getConnection( std::chrono::milliseconds( 100 ) );
+    } catch ( dbcpp::DBException & ) {
+    }
+  } );
+
+  while ( pool.stats( ).waiting == 0 ) {
+    std::this_thread::yield( );
+  }
+
+  try {
+    pool.getConnection( std::chrono::seconds( 5 ) );
+  } catch ( dbcpp::PoolUnavailable & ) {
+    rejected = true;
+  }
+
+  waiter.join( );
+  CHECK( rejected );
+}
+
+/**
+ * @brief Reserved connections are only leased to high priority checkouts
+ */
+static void testReserved( ) {
+  dbcpp::PoolOptions options;
+  bool               timedOut = false;
+
+  options.minIdle  = 2;
+  options.maxSize  = 2;
+  options.reserved = 1;
+
+  dbcpp::Pool pool( SQLITEURI, options );
+  auto        normal = pool.getConnection( );
+
+  try {
+    pool.getConnection( std::chrono::milliseconds( 10 ) );
+  } catch ( dbcpp::DBException & ) {
+    timedOut = true;
+  }
+
+  CHECK( timedOut );
+
+  auto high = pool.getConnection( std::chrono::milliseconds( 10 ), dbcpp::PoolOptions::HIGH );
+
+  CHECK( pool.stats( ).classTimeouts[ dbcpp::PoolOptions::NORMAL ] == 1 );
+  CHECK( pool.stats( ).classWaitTime[ dbcpp::PoolOptions::HIGH ].count == 1 );
+}
+
+/**
+ * @brief Waiters are served by priority, unless a lower priority waiter has aged past it
+ * @param aging wait worth one priority class
+ * @param first expected first served priority
+ */
+static void testPriorityOrder( std::chrono::milliseconds aging, dbcpp::PoolOptions::Priority first ) {
+  dbcpp::PoolOptions                          options;
+  std::mutex                                  lock;
+  std::vector< dbcpp::PoolOptions::Priority > served;
+  std::vector< std::thread >                  threads;
+
+  options.minIdle       = 1;
+  options.maxSize       = 1;
+  options.priorityAging = aging;
+
+  dbcpp::Pool pool( SQLITEURI, options );
+
+  {
+    auto held = pool.getConnection( );
+
+    for ( auto priority : { dbcpp::PoolOptions::LOW, dbcpp::PoolOptions::HIGH } ) {
+      auto parked = pool.stats( ).waiting;
+
+      threads.emplace_back( [ &, priority ]( ) {
+        auto cxn = pool.getConnection( std::chrono::seconds( 5 ), priority );
+
+        std::lock_guard< std::mutex > guard( lock );
+        served.push_back( priority );
+      } );
+
+      while ( pool.stats( ).waiting == parked ) {
+        std::this_thread::yield( );
+      }
+
+      std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    }
+  }
+
+  for ( auto &&thread : threads ) {
+    thread.join( );
+  }
+
+  CHECK( served.size( ) == 2 );
+  CHECK( !served.empty( ) && ( served.front( ) == first ) );
+}
+
+/**
+ * @brief Connections past their maximum lifetime are replaced without reducing the pool size
+ */
+static void testMaxLifetime( ) {
+  dbcpp::PoolOptions options;
+
+  options.minIdle     = 1;
+  options.maxSize     = 1;
+  options.maxLifetime = std::chrono::milliseconds( 40 );
+
+  dbcpp::Pool pool( SQLITEURI, options );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+  {
+    auto cxn = pool.getConnection( std::chrono::seconds( 1 ) );
+
+    CHECK( cxn.test( ) );
+    CHECK( pool.size( ) == 1 );
+  }
+
+  CHECK( pool.stats( ).retired >= 1 );
+}
+
+/**
+ * @brief Leases held too long are reported with their call site, then reclaimed
+ */
+static void testLeakDetection( ) {
+  dbcpp::PoolOptions options;
+
+  options.minIdle       = 1;
+  options.maxSize       = 1;
+  options.leakThreshold = std::chrono::milliseconds( 20 );
+  options.reclaimAfter  = std::chrono::milliseconds( 60 );
+
+  dbcpp::Pool pool( SQLITEURI, options );
+  auto        leaked = pool.getConnection( dbcpp::PoolOptions::NORMAL, DBCPP_CALL_SITE );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+
+  auto stats = pool.stats( );
+
+  CHECK( stats.leaks == 1 );
+  CHECK( stats.leases.size( ) == 1 );
+  CHECK( !stats.leases.empty( ) && stats.leases.front( ).site && strstr( stats.leases.front( ).site, "pool_test" ) );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 80 ) );
+
+  CHECK( pool.stats( ).reclaimed == 1 );
+  CHECK( leaked.test( ) );
+
+  {
+    auto cxn = pool.getConnection( std::chrono::milliseconds( 100 ) );
+
+    CHECK( cxn.test( ) );
+  }
+
+  /* Its holder keeps using the reclaimed connection, the slot having opened a new one */
+  CHECK( leaked.test( ) );
+
+  /* Releasing the reclaimed lease must not return it to the pool a second time */
+  leaked = dbcpp::Connection( nullptr );
+
+  CHECK( pool.size( ) == 1 );
+  CHECK( pool.idle( ) == 1 );
+}
+
+/**
+ * @brief Writes go to the primary, reads are spread across the healthy replicas and fail over
+ *        to the primary, and endpoints that can not be reached receive nothing
+ */
+static void testClusterRouting( ) {
+  using Cluster = dbcpp::ClusterPool;
+
+  dbcpp::ClusterOptions options;
+  std::string           down = "sqlite:///nonexistent/directory/pool.db";
+
+  options.healthInterval = std::chrono::milliseconds( 50 );
+
+  {
+    Cluster cluster( { { SQLITEURI, Cluster::PRIMARY },
+                       { SQLITEURI, Cluster::REPLICA },
+                       { SQLITEURI, Cluster::REPLICA },
+                       { down, Cluster::REPLICA } },
+                     options );
+
+    CHECK( cluster.healthy( 0 ) && cluster.healthy( 1 ) && cluster.healthy( 2 ) );
+    CHECK( !cluster.healthy( 3 ) );
+
+    auto write = cluster.getConnection( Cluster::READ_WRITE );
+    auto read1 = cluster.getConnection( Cluster::READ_ONLY );
+    auto read2 = cluster.getConnection( Cluster::READ_ONLY );
+
+    CHECK( cluster.pool( 0 ).inUse( ) == 1 );
+    CHECK( cluster.pool( 1 ).inUse( ) == 1 );
+    CHECK( cluster.pool( 2 ).inUse( ) == 1 );
+    CHECK( cluster.pool( 3 ).inUse( ) == 0 );
+  }
+
+  {
+    /* An exhausted replica fails over to the primary, rather than using up the timeout */
+    dbcpp::ClusterOptions single = options;
+
+    single.pool.minIdle = 1;
+    single.pool.maxSize = 1;
+
+    Cluster cluster( { { SQLITEURI, Cluster::PRIMARY }, { SQLITEURI, Cluster::REPLICA } }, single );
+    auto    read1 = cluster.getConnection( Cluster::READ_ONLY );
+    auto    read2 = cluster.getConnection( Cluster::READ_ONLY, std::chrono::seconds( 10 ) );
+
+    CHECK( cluster.pool( 0 ).inUse( ) == 1 );
+    CHECK( cluster.pool( 1 ).inUse( ) == 1 );
+
+    /* Without a deadline, the checkout still takes turns on the endpoints rather than waiting on the first */
+    std::thread release( [ &read2 ]( ) {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+      read2 = dbcpp::Connection( nullptr );
+    } );
+
+    auto read3 = cluster.getConnection( Cluster::READ_ONLY );
+
+    release.join( );
+
+    CHECK( cluster.pool( 0 ).inUse( ) == 1 );
+    CHECK( cluster.pool( 1 ).inUse( ) == 1 );
+  }
+
+  {
+    /* No replica up: reads fall back to the primary */
+    Cluster cluster( { { SQLITEURI, Cluster::PRIMARY }, { down, Cluster::REPLICA } }, options );
+    auto    read = cluster.getConnection( Cluster::READ_ONLY );
+
+    CHECK( cluster.pool( 0 ).inUse( ) == 1 );
+  }
+
+  {
+    /* No primary up: writes are rejected, reads still served */
+    Cluster cluster( { { down, Cluster::PRIMARY }, { SQLITEURI, Cluster::REPLICA } }, options );
+    bool    rejected = false;
+
+    try {
+      cluster.getConnection( Cluster::READ_WRITE );
+    } catch ( dbcpp::PoolUnavailable & ) {
+      rejected = true;
+    }
+
+    CHECK( rejected );
+    CHECK( cluster.getConnection( Cluster::READ_ONLY ).test( ) );
+  }
+}
+
+/**
+ * @brief Reads carrying a commit position only go to replicas known to have replayed it
+ */
+static void testClusterConsistency( ) {
+  using Cluster = dbcpp::ClusterPool;
+
+  Cluster cluster( { { SQLITEURI, Cluster::PRIMARY }, { SQLITEURI, Cluster::REPLICA } }, dbcpp::ClusterOptions( ) );
+
+  {
+    auto write = cluster.getConnection( Cluster::READ_WRITE );
+
+    write.commit( );
+    CHECK( write.commitPosition( ) == 0 ); // Not tracked by SQLite
+  }
+
+  {
+    auto read = cluster.getConnection( Cluster::READ_ONLY, 0, std::chrono::milliseconds( 100 ) );
+
+    CHECK( cluster.pool( 1 ).inUse( ) == 1 );
+  }
+
+  {
+    /* The replica's position is unknown, so it can not be shown to have caught up */
+    auto read = cluster.getConnection( Cluster::READ_ONLY, 1, std::chrono::milliseconds( 100 ) );
+
+    CHECK( cluster.pool( 0 ).inUse( ) == 1 );
+    CHECK( cluster.pool( 1 ).inUse( ) == 0 );
+  }
+}
+
+/**
+ * @brief A checkout steals from another shard only when the local shard has nothing free
+ */
+static void testShardedPool( ) {
+  dbcpp::ShardOptions options;
+
+  options.pool.minIdle = 2;
+  options.pool.maxSize = 2;
+  options.shards       = 2;
+
+  dbcpp::ShardedPool pool( SQLITEURI, options );
+
+  CHECK( pool.size( ) == 2 );
+  CHECK( pool.shard( 0 ).size( ) == 1 );
+  CHECK( pool.shard( 1 ).size( ) == 1 );
+
+  auto home  = pool.localShard( );
+  auto local = pool.getConnection( );
+  auto other = pool.getConnection( );
+
+  CHECK( pool.shard( home ).inUse( ) == 1 );
+  CHECK( pool.shard( 1 - home ).inUse( ) == 1 );
+  CHECK( pool.stats( home ).stolen == 1 );
+  CHECK( pool.stats( 1 - home ).lent == 1 );
+
+  bool timedOut = false;
+
+  try {
+    pool.getConnection( std::chrono::milliseconds( 20 ) );
+  } catch ( dbcpp::DBException & ) {
+    timedOut = true;
+  }
+
+  CHECK( timedOut );
+}
+
+/**
+ * @brief Asynchronous checkouts complete on release, on their deadline or when cancelled
+ */
+static void testAsyncCheckout( ) {
+  dbcpp::Pool        pool( SQLITEURI, 1 );
+  std::atomic< int > completed{ 0 };
+  std::atomic< int > failed{ 0 };
+
+  /* Run by the canceller, the monitor expiring checkouts, or the releaser */
+  auto handler = [ & ]( std::exception_ptr error, dbcpp::Connection connection ) { ++( error ? failed : completed ); };
+
+  {
+    auto ready = pool.getConnectionAsync( std::chrono::milliseconds( 100 ) );
+
+    CHECK( ready.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready );
+  }
+
+  {
+    auto held     = pool.getConnection( );
+    auto released = pool.getConnectionAsync( handler );
+    auto expiring = pool.getConnectionAsync( handler, std::chrono::milliseconds( 20 ) );
+    auto dropped  = pool.getConnectionAsync( handler );
+
+    CHECK( dropped.cancel( ) );
+    CHECK( !dropped.cancel( ) );
+    CHECK( failed == 1 );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+    CHECK( failed == 2 );
+    CHECK( completed == 0 );
+  }
+
+  /* Completed by the release of the held connection, which it then released */
+  CHECK( completed == 1 );
+  CHECK( pool.idle( ) == 1 );
+  CHECK( pool.stats( ).waiting == 0 );
+}
+
+/**
+ * @brief Idle pool monitors sleep rather than poll
+ */
+static void testIdleMonitor( ) {
+  std::vector< std::unique_ptr< dbcpp::Pool > > pools;
+
+  for ( int num = 0; num < 50; ++num ) {
+    pools.emplace_back( new dbcpp::Pool( SQLITEURI, 1 ) );
+  }
+
+  auto start = std::clock( );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+
+  CHECK( std::clock( ) - start < CLOCKS_PER_SEC / 50 );
+}
+
+/**
+ * @brief Draining rejects checkouts until every lease is back, and rebinding replaces the idle
+ *        connections of the earlier target
+ */
+static void testDrainRebind( ) {
+  auto target = "/tmp/pool_test_" + std::to_string( std::chrono::system_clock::now( ).time_since_epoch( ).count( ) );
+
+  {
+    dbcpp::Pool pool( SQLITEURI, 1 );
+
+    {
+      auto held = pool.getConnection( );
+
+      CHECK( !pool.drain( std::chrono::milliseconds( 50 ) ) );
+
+      try {
+        pool.getConnection( std::chrono::milliseconds( 10 ) );
+        CHECK( false );
+      } catch ( dbcpp::PoolUnavailable & ) {
+      }
+    }
+
+    CHECK( pool.drain( std::chrono::milliseconds( 50 ) ) );
+
+    pool.resume( );
+    pool.rebind( "sqlite://" + target );
+
+    /* The idle connection of the earlier binding is replaced by the monitor */
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+    {
+      auto cxn = pool.getConnection( std::chrono::seconds( 1 ) );
+
+      CHECK( cxn.test( ) );
+    }
+
+    CHECK( pool.stats( ).retired >= 1 );
+    CHECK( pool.size( ) == 1 );
+  }
+
+  CHECK( std::remove( target.c_str( ) ) == 0 );
+}
+
+/**
+ * @brief A hinted checkout prefers an idle connection with the statement already prepared
+ */
+static void testAffinity( ) {
+  dbcpp::PoolOptions options;
+
+  options.minIdle = 2;
+  options.maxSize = 2;
+
+  dbcpp::Pool pool( SQLITEURI, options );
+
+  {
+    auto cold = pool.getConnection( );
+
+    {
+      auto warm = pool.getConnection( );
+
+      warm.createStatement( "SELECT 1" );
+    }
+  }
+
+  /* The connection without the statement is the most recently used, and passed over */
+  {
+    auto cxn = pool.getConnection( "SELECT 1", std::chrono::seconds( 1 ) );
+
+    CHECK( cxn.statementCache( ).contains( "SELECT 1" ) );
+    CHECK( pool.idle( ) == 1 );
+  }
+
+  {
+    auto cxn = pool.getConnection( "SELECT 2", std::chrono::seconds( 1 ) );
+
+    CHECK( !cxn.statementCache( ).contains( "SELECT 2" ) );
+  }
+
+  auto stats = pool.stats( );
+
+  CHECK( stats.affinityHits == 1 );
+  CHECK( stats.affinityMisses == 1 );
+  CHECK( pool.idle( ) == 2 );
+}
+
+/**
+ * @brief Hot statements are prepared on every new connection, a failing one not keeping the
+ *        others from being prepared
+ */
+static void testHotStatements( ) {
+  dbcpp::PoolOptions options;
+
+  options.minIdle       = 1;
+  options.maxSize       = 2;
+  options.hotStatements = { "SELECT FROM nowhere", "SELECT 1" };
+
+  dbcpp::Pool pool( SQLITEURI, options );
+
+  /* Opened by the constructor, then on demand */
+  auto first  = pool.getConnection( "SELECT 1", std::chrono::seconds( 1 ) );
+  auto second = pool.getConnection( std::chrono::seconds( 1 ) );
+
+  CHECK( first.statementCache( ).contains( "SELECT 1" ) );
+  CHECK( second.statementCache( ).contains( "SELECT 1" ) );
+  CHECK( pool.stats( ).affinityHits == 1 );
+}
+
+/**
+ * @brief Batched parameter sets are applied together, a failing one rolling back the batch
+ */
+static void testBatch( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  auto        cxn = pool.getConnection( );
+
+  cxn.createStatement( "CREATE TABLE batched ( id INTEGER PRIMARY KEY, name TEXT )" ).execute( );
+
+  auto insert = cxn.createStatement( "INSERT INTO batched ( id, name ) VALUES ( ?, ? )" );
+
+  for ( int32_t id = 1; id <= 3; ++id ) {
+    insert << id << std::to_string( id );
+    insert.addBatch( );
+  }
+
+  auto counts = insert.executeBatch( );
+
+  CHECK( counts == std::vector< int >( 3, 1 ) );
+  CHECK( insert.executeBatch( ).empty( ) );
+
+  /* A failed parameter set rolls back the whole batch */
+  insert << 4 << "4";
+  insert.addBatch( );
+  insert << 1 << "duplicate";
+  insert.addBatch( );
+
+  try {
+    insert.executeBatch( );
+    CHECK( false );
+  } catch ( dbcpp::DBException & ) {
+  }
+
+  auto update = cxn.createStatement( "UPDATE batched SET name = ? WHERE id >= ?" );
+
+  update << "updated" << 2;
+  update.addBatch( );
+  update << "updated" << 4;
+  update.addBatch( );
+
+  CHECK( update.executeBatch( ) == std::vector< int >( { 2, 0 } ) );
+
+  auto result = cxn.createStatement( "SELECT COUNT( * ) FROM batched" ).executeQuery( );
+
+  CHECK( result.next( ) );
+  CHECK( result.get< int32_t >( 0 ) == 3 );
+
+  cxn.createStatement( "DROP TABLE batched" ).execute( );
+}
+
+/**
+ * @brief Borrowed string and blob parameters are sent without a copy, and read at execution
+ */
+static void testBorrowedBinds( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  auto        cxn = pool.getConnection( );
+
+  cxn.createStatement( "CREATE TABLE borrowed ( id INTEGER PRIMARY KEY, doc TEXT, data BLOB )" ).execute( );
+
+  std::string    doc    = "{\"key\": \"value\"}";
+  dbcpp::VarByte data   = { 0, 1, 2, 255 };
+  auto           insert = cxn.createStatement( "INSERT INTO borrowed ( id, doc, data ) VALUES ( ?, ?, ? )" );
+
+  insert << 1 << dbcpp::StringRef( doc ) << dbcpp::ByteRef( data );
+  CHECK( insert.executeUpdate( ) == 1 );
+
+  /* Batched borrowed values are read at executeBatch( ) */
+  insert << 2 << dbcpp::StringRef( doc.data( ), 1 ) << dbcpp::ByteRef( nullptr, 0 );
+  insert.addBatch( );
+  CHECK( insert.executeBatch( ) == std::vector< int >( 1, 1 ) );
+
+  auto result = cxn.createStatement( "SELECT doc, data FROM borrowed ORDER BY id" ).executeQuery( );
+
+  CHECK( result.next( ) );
+  CHECK( result.get< std::string >( 0 ) == doc );
+  CHECK( result.get< dbcpp::VarByte >( 1 ) == data );
+  CHECK( result.next( ) );
+  CHECK( result.get< std::string >( 0 ) == "{" );
+  CHECK( result.get< dbcpp::VarByte >( 1 ).empty( ) );
+
+  cxn.createStatement( "DROP TABLE borrowed" ).execute( );
+}
+
+/**
+ * @brief Parameters bound to host variables take their current values at each execution
+ */
+static void testHostVariables( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  auto        cxn = pool.getConnection( );
+
+  cxn.createStatement( "CREATE TABLE hosted ( id INTEGER PRIMARY KEY, name TEXT, score REAL )" ).execute( );
+
+  int32_t     id     = 0;
+  std::string name;
+  double      score  = 0;
+  bool        noName = false;
+  auto        insert = cxn.createStatement( "INSERT INTO hosted ( id, name, score ) VALUES ( ?, ?, ? )" );
+
+  CHECK( insert.bindParam( 0, &id ) );
+  CHECK( insert.bindParam( 1, &name, &noName ) );
+  CHECK( insert.bindParam( 2, &score ) );
+
+  /* Each execution reads the current values */
+  for ( id = 1; id <= 3; ++id ) {
+    name  = "name " + std::to_string( id );
+    score = id / 2.0;
+    CHECK( insert.executeUpdate( ) == 1 );
+  }
+
+  /* Batched sets keep the values current when added */
+  for ( ; id <= 5; ++id ) {
+    noName = id == 5;
+    insert.addBatch( );
+  }
+
+  CHECK( insert.executeBatch( ) == std::vector< int >( 2, 1 ) );
+
+  auto result = cxn.createStatement( "SELECT id, name, score FROM hosted ORDER BY id" ).executeQuery( );
+
+  for ( int32_t expected = 1; expected <= 5; ++expected ) {
+    CHECK( result.next( ) );
+    CHECK( result.get< int32_t >( 0 ) == expected );
+
+    if ( expected < 5 ) {
+      CHECK( result.get< std::string >( 1 ) == "name " + std::to_string( std::min( expected, 3 ) ) );
+    } else {
+      CHECK( result.isNull( 1 ) );
+    }
+  }
+
+  CHECK( !result.next( ) );
+
+  insert.unbindParams( );
+  CHECK( ( insert << 6 << "six" << 6.0 ).executeUpdate( ) == 1 );
+
+  cxn.createStatement( "DROP TABLE hosted" ).execute( );
+}
+
+/**
+ * @brief Bound columns receive each row's values on next( ), a null leaving the variable as it was
+ */
+static void testColumnBinding( ) {
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  auto        cxn = pool.getConnection( );
+
+  cxn.createStatement( "CREATE TABLE columns ( id INTEGER PRIMARY KEY, name TEXT, score REAL )" ).execute( );
+  cxn.createStatement( "INSERT INTO columns VALUES ( 1, 'one', 0.5 ), ( 2, NULL, 1.5 )" ).execute( );
+
+  int64_t     id     = 0;
+  std::string name;
+  double      score  = 0;
+  bool        noName = false;
+  auto        result = cxn.createStatement( "SELECT id, name, score FROM columns ORDER BY id" ).executeQuery( );
+
+  CHECK( result.bindColumn( 0, &id ) );
+  CHECK( result.bindColumn( 1, &name, &noName ) );
+  CHECK( result.bindColumn( 2, &score ) );
+  CHECK( !result.bindColumn( 3, &score ) );
+
+  CHECK( result.next( ) );
+  CHECK( ( id == 1 ) && ( name == "one" ) && !noName && ( score == 0.5 ) );
+
+  /* A null leaves the variable as it was */
+  CHECK( result.next( ) );
+  CHECK( ( id == 2 ) && ( name == "one" ) && noName && ( score == 1.5 ) );
+
+  CHECK( !result.next( ) );
+
+  cxn.createStatement( "DROP TABLE columns" ).execute( );
+}
+
+/**
+ * @brief Typed queries check their placeholder count when built, and bind their arguments by type
+ */
+static void testTypedQuery( ) {
+  static constexpr dbcpp::TypedQuery< int32_t, std::string > insertQuery{
+    "  INSERT INTO typed ( id, name ) VALUES ( ?, ? ) -- '?' "
+  };
+  static constexpr dbcpp::TypedQuery< std::string > selectQuery{
+    "SELECT id FROM typed WHERE name <> '?' AND name = ?"
+  };
+
+  static constexpr dbcpp::TypedQuery<> blankQuery{ " \t\n " };
+
+  static_assert( dbcpp::internal::utils::placeholders( "? '?' ''? ?", 0, 11 ) == 3, "Quoted placeholders count" );
+
+  CHECK( blankQuery.query( ).empty( ) );
+
+  dbcpp::Pool pool( SQLITEURI, 1 );
+  auto        cxn = pool.getConnection( );
+
+  cxn.createStatement( "CREATE TABLE typed ( id INTEGER PRIMARY KEY, name TEXT )" ).execute( );
+
+  {
+    auto insert = cxn.createStatement( insertQuery );
+
+    CHECK( insertQuery.query( ) == "INSERT INTO typed ( id, name ) VALUES ( ?, ? ) -- '?'" );
+    CHECK( insert.executeUpdate( 1, "one" ) == 1 );
+    CHECK( insert.executeUpdate( 2, "two" ) == 1 );
+
+    insert.addBatch( 3, "three" );
+    insert.addBatch( 4, "four" );
+    CHECK( insert.executeBatch( ) == std::vector< int >( 2, 1 ) );
+  }
+
+  auto select = cxn.createStatement( selectQuery );
+
+  for ( auto &&name : { "one", "three" } ) {
+    auto result = select.executeQuery( name );
+
+    CHECK( result.next( ) );
+    CHECK( result.get< int32_t >( 0 ) == ( name == std::string( "one" ) ? 1 : 3 ) );
+    CHECK( !result.next( ) );
+  }
+
+  try {
+    dbcpp::TypedQuery< int32_t > mismatched( "SELECT ?, ?" );
+    CHECK( false );
+  } catch ( dbcpp::DBException & ) {
+  }
+
+  cxn.createStatement( "DROP TABLE typed" ).execute( );
+}
+
+int main( int argc, char *argv[] ) {
+  log_init( );
+
+  testCheckoutTimeout( );
+  testCheckoutWakeup( );
+  testLeaseCopies( );
+  testElasticSizing( );
+  testIdleChecks( );
+  testStats( );
+  testStatementCache( );
+  testCircuitBreaker( );
+  testWaiterLimit( );
+  testReserved( );
+  testPriorityOrder( std::chrono::seconds( 1 ), dbcpp::PoolOptions::HIGH );
+  testPriorityOrder( std::chrono::milliseconds( 1 ), dbcpp::PoolOptions::LOW );
+  testMaxLifetime( );
+  testLeakDetection( );
+  testClusterRouting( );
+  testClusterConsistency( );
+  testShardedPool( );
+  testAsyncCheckout( );
+  testDrainRebind( );
+  testAffinity( );
+  testHotStatements( );
+  testBatch( );
+  testBorrowedBinds( );
+  testHostVariables( );
+  testColumnBinding( );
+  testTypedQuery( );
+  testIdleMonitor( );
+
+  std::cout << ( failures ? "FAILED" : "PASSED" ) << "\n";
+
+  return failures ? 1 : 0;
+}